@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "AnalogStream.h"
+#include "zephyrInternal.h"
+
+#ifdef CONFIG_ADC_ASYNC
+
+arduino::AnalogStream::AnalogStream(pin_size_t pin) : _pin(pin) {
+}
+
+arduino::AnalogStream::~AnalogStream() {
+	end();
+}
+
+int arduino::AnalogStream::begin(uint32_t sampleRate, uint16_t *buffer, size_t count,
+								 AnalogStreamCallback cb) {
+	int err;
+
+	if (_running) {
+		return -EBUSY;
+	}
+
+	/* extra_samplings is 16 bit wide, so a half buffer is at most 65536 samples */
+	if (!buffer || !cb || count == 0 || count > (UINT16_MAX + 1)) {
+		return -EINVAL;
+	}
+
+	_adc = analogPinToAdcSpec(_pin);
+	if (!_adc) {
+		return -EINVAL;
+	}
+
+	if (_adc->resolution > 16) {
+		return -ENOTSUP;
+	}
+
+	err = adc_channel_setup_dt(_adc);
+	if (err < 0) {
+		return err;
+	}
+
+	_buffer = buffer;
+	_count = count;
+	_cb = cb;
+	_overruns = 0;
+
+	_options = {};
+	_options.interval_us = sampleRate ? (USEC_PER_SEC / sampleRate) : 0;
+	_options.callback = samplingDone;
+	_options.user_data = this;
+	_options.extra_samplings = count - 1;
+
+	_sequence = {};
+	_sequence.options = &_options;
+	_sequence.channels = BIT(_adc->channel_id);
+	_sequence.buffer_size = count * sizeof(uint16_t);
+	_sequence.resolution = _adc->resolution;
+	_sequence.oversampling = analogPinOversampling(_pin);
+
+	k_poll_signal_init(&_signal);
+
+	_running = true;
+	err = start(0);
+	if (err < 0) {
+		_running = false;
+		return err;
+	}
+
+	k_thread_create(&_thread, _stack, K_KERNEL_STACK_SIZEOF(_stack), threadEntry, this, NULL,
+					NULL, CONFIG_ARDUINO_ANALOG_STREAM_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&_thread, "analog_stream");
+
+	return 0;
+}
+
+void arduino::AnalogStream::end() {
+	if (!_running) {
+		return;
+	}
+
+	/* The sampling callback finishes the pending sequence, which wakes the thread up */
+	_running = false;
+	k_thread_join(&_thread, K_FOREVER);
+}
+
+int arduino::AnalogStream::resolution() const {
+	return _adc ? _adc->resolution : 0;
+}
+
+int arduino::AnalogStream::start(size_t half) {
+	_sequence.buffer = &_buffer[half * _count];
+	return adc_read_async(_adc->dev, &_sequence, &_signal);
+}
+
+void arduino::AnalogStream::threadEntry(void *p1, void *p2, void *p3) {
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	static_cast<AnalogStream *>(p1)->run();
+}
+
+enum adc_action arduino::AnalogStream::samplingDone(const struct device *dev,
+													const struct adc_sequence *sequence,
+													uint16_t sampling_index) {
+	AnalogStream *stream = static_cast<AnalogStream *>(sequence->options->user_data);
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(sampling_index);
+
+	return stream->_running ? ADC_ACTION_CONTINUE : ADC_ACTION_FINISH;
+}
+
+void arduino::AnalogStream::run() {
+	struct k_poll_event event =
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &_signal);
+	size_t filled = 0;
+	/* begin() started the first sequence */
+	bool armed = true;
+	unsigned int signaled;
+	int result;
+
+	while (_running) {
+		k_poll(&event, 1, K_FOREVER);
+		event.state = K_POLL_STATE_NOT_READY;
+
+		k_poll_signal_check(&_signal, &signaled, &result);
+		k_poll_signal_reset(&_signal);
+		armed = false;
+
+		if (!_running || result < 0) {
+			break;
+		}
+
+		/* Re-arm the ADC on the other half before handing out the full one */
+		if (start(filled ^ 1) < 0) {
+			_running = false;
+		} else {
+			armed = true;
+		}
+
+		_cb(&_buffer[filled * _count], _count);
+
+		/* The next half completed while the callback ran: the ADC sat idle */
+		k_poll_signal_check(&_signal, &signaled, &result);
+		if (signaled) {
+			_overruns++;
+		}
+
+		filled ^= 1;
+	}
+
+	/*
+	 * end() can stop the loop while a sequence is still running. The
+	 * sampling callback finishes it at the next sample; wait for that so
+	 * that a following begin() gets the buffers and the signal to itself.
+	 */
+	if (armed) {
+		k_poll(&event, 1, K_FOREVER);
+		k_poll_signal_reset(&_signal);
+	}
+
+	_running = false;
+}
+
+#endif // CONFIG_ADC_ASYNC
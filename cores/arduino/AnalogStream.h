@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef CONFIG_ADC_ASYNC
+
+namespace arduino {
+
+typedef void (*AnalogStreamCallback)(const uint16_t *samples, size_t count);
+
+/*
+ * Continuous sampling of one analog pin into a pair of ping-pong buffers.
+ *
+ * The ADC fills one half of the user buffer through adc_read_async() while
+ * the other half is handed to the callback from a dedicated thread. If the
+ * callback is still running when the next half is complete, the ADC idles
+ * until it returns and the event is counted in overruns().
+ *
+ * Samples are raw values at the channel resolution set in devicetree.
+ */
+class AnalogStream {
+public:
+	AnalogStream(pin_size_t pin);
+	~AnalogStream();
+
+	/*
+	 * Start sampling. `buffer` must hold 2 * `count` samples. A `sampleRate`
+	 * of 0 samples back-to-back as fast as the ADC allows; otherwise the
+	 * interval is timed by the ADC driver, which on most SoCs is bound to
+	 * the kernel tick rate.
+	 */
+	int begin(uint32_t sampleRate, uint16_t *buffer, size_t count, AnalogStreamCallback cb);
+	void end();
+
+	uint32_t overruns() const {
+		return _overruns;
+	}
+
+	int resolution() const;
+
+private:
+	static void threadEntry(void *p1, void *p2, void *p3);
+	static enum adc_action samplingDone(const struct device *dev,
+										const struct adc_sequence *sequence,
+										uint16_t sampling_index);
+	int start(size_t half);
+	void run();
+
+	pin_size_t _pin;
+	const struct adc_dt_spec *_adc = nullptr;
+	struct adc_sequence_options _options;
+	struct adc_sequence _sequence;
+	struct k_poll_signal _signal;
+	uint16_t *_buffer = nullptr;
+	size_t _count = 0;
+	AnalogStreamCallback _cb = nullptr;
+	volatile bool _running = false;
+	uint32_t _overruns = 0;
+
+	struct k_thread _thread;
+	K_KERNEL_STACK_MEMBER(_stack, CONFIG_ARDUINO_ANALOG_STREAM_STACK_SIZE);
+};
+
+} // namespace arduino
+
+using arduino::AnalogStream;
+
+#endif // CONFIG_ADC_ASYNC
@@ -112,6 +112,23 @@ enum analogPins {
 // We provide analogReadResolution APIs
 void analogReadResolution(int bits);
 
+// Hardware averaging of 'ratio' samples per analogRead(), cached per channel
+int analogReadOversampling(pin_size_t pinNumber, uint16_t ratio);
+
+// Run the ADC self-calibration once on every converter
+int analogCalibrate(void);
+
+#endif
+
+#ifdef CONFIG_PWM
+
+// Set the pwm frequency of a pin. Channels of the same pwm device share it, and those already
+// driven by analogWrite() are updated right away, keeping their duty cycle.
+int analogWriteFrequency(pin_size_t pinNumber, uint32_t frequency);
+
+// Update several pwm pins back-to-back with one call
+int analogWriteMany(const pin_size_t *pins, const int *values, size_t count);
+
 #endif
 
 #ifdef CONFIG_DAC
@@ -131,8 +148,38 @@ enum dacPins {
 void interrupts(void);
 void noInterrupts(void);
 
+// Fill a buffer with pseudo-random bytes from the random() generator
+void randomBytes(void *buf, size_t len);
+
 int digitalPinToInterrupt(pin_size_t pin);
 
+// Only call the interrupt handler once the pin has been stable for 'us' microseconds (0 disables).
+// Like the rate limit, it is dropped by detachInterrupt().
+int setInterruptDebounce(pin_size_t pinNumber, unsigned long us);
+
+// Mask the pin interrupt for the rest of the second once it fires more than 'maxPerSecond' times
+int setInterruptRateLimit(pin_size_t pinNumber, unsigned int maxPerSecond);
+
+// Number of times the rate limit masked the pin interrupt. Each episode lasts until the end of the
+// one-second window and counts once, however many interrupts were missed while masked.
+unsigned long getInterruptThrottleCount(pin_size_t pinNumber);
+
+// Sources that can wake up an event driven loop()
+#define LOOP_EVENT_SERIAL BIT(0)
+#define LOOP_EVENT_GPIO   BIT(1)
+#define LOOP_EVENT_TIMER  BIT(2)
+#define LOOP_EVENT_USER   BIT(3)
+#define LOOP_EVENT_ALL    (LOOP_EVENT_SERIAL | LOOP_EVENT_GPIO | LOOP_EVENT_TIMER | LOOP_EVENT_USER)
+
+// Only call loop() again once an event arrives, or after maxSleepMs (0 sleeps until an event)
+int loopOnEvents(unsigned long maxSleepMs = 0);
+// Go back to calling loop() back to back
+void loopContinuously(void);
+// Wake up an event driven loop(), safe to call from interrupts
+void wake(uint32_t events = LOOP_EVENT_USER);
+// Events that ended the last sleep, 0 if it timed out
+uint32_t loopWakeEvents(void);
+
 #define digitalPinToPort(x)    (x)
 #define digitalPinToBitMask(x) (x)
 #define portOutputRegister(x)  (x)
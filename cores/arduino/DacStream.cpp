@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "DacStream.h"
+#include "zephyrInternal.h"
+#include <zephyr/drivers/counter.h>
+
+#if defined(CONFIG_DAC) && defined(CONFIG_COUNTER)
+
+arduino::DacStream::DacStream(enum dacPins dac) : _dac(dac) {
+	k_work_init(&_refill.work, refill);
+	_refill.stream = this;
+	k_sem_init(&_done, 0, 1);
+}
+
+int arduino::DacStream::begin(uint32_t sampleRate, uint16_t *buffer, size_t count,
+							  DacStreamCallback cb) {
+	if (_counter) {
+		return -EBUSY;
+	}
+
+	if (!buffer || !cb || count == 0) {
+		return -EINVAL;
+	}
+
+	_buffer = buffer;
+	_cb = cb;
+
+	/* Prime both halves before the first sample goes out */
+	cb(&buffer[0], count);
+	cb(&buffer[count], count);
+
+	return start(sampleRate, buffer, count);
+}
+
+int arduino::DacStream::play(uint32_t sampleRate, const uint16_t *samples, size_t count) {
+	int err;
+
+	if (_counter) {
+		return -EBUSY;
+	}
+
+	_buffer = nullptr;
+	_cb = nullptr;
+
+	err = start(sampleRate, samples, count);
+	if (err < 0) {
+		return err;
+	}
+
+	k_sem_take(&_done, K_FOREVER);
+	end();
+
+	return 0;
+}
+
+void arduino::DacStream::end() {
+	struct k_work_sync sync;
+
+	if (!_counter) {
+		return;
+	}
+
+	/* Stopped first so the interrupt cannot queue the refill again, then wait for it */
+	counter_stop(_counter);
+	k_work_cancel_sync(&_refill.work, &sync);
+
+	counterRelease(_counter);
+	_counter = nullptr;
+}
+
+int arduino::DacStream::start(uint32_t sampleRate, const uint16_t *samples, size_t count) {
+	struct counter_top_cfg top_cfg = {};
+	uint32_t ticks;
+	int err;
+
+	if (!samples || count == 0 || sampleRate == 0) {
+		return -EINVAL;
+	}
+
+	err = dacChannelSetup(_dac, &_dev, &_cfg);
+	if (err < 0) {
+		return err;
+	}
+
+	_counter = counterAcquire();
+	if (!_counter) {
+		return -ENODEV;
+	}
+
+	ticks = counter_get_frequency(_counter) / sampleRate;
+	if (ticks == 0 || ticks > counter_get_max_top_value(_counter)) {
+		err = -ERANGE;
+		goto release;
+	}
+
+	_samples = samples;
+	_count = count;
+	_pos = 0;
+	_underruns = 0;
+	atomic_clear(&_pending);
+	k_sem_reset(&_done);
+
+	top_cfg.ticks = ticks;
+	top_cfg.callback = counterTop;
+	top_cfg.user_data = this;
+
+	err = counter_set_top_value(_counter, &top_cfg);
+	if (err < 0) {
+		goto release;
+	}
+
+	err = counter_start(_counter);
+	if (err < 0) {
+		goto release;
+	}
+
+	return 0;
+
+release:
+	counterRelease(_counter);
+	_counter = nullptr;
+	return err;
+}
+
+void arduino::DacStream::counterTop(const struct device *dev, void *user_data) {
+	DacStream *stream = static_cast<DacStream *>(user_data);
+	size_t half;
+
+	dac_write_value(stream->_dev, stream->_cfg->channel_id, stream->_samples[stream->_pos]);
+
+	if (++stream->_pos != stream->_count && stream->_pos != 2 * stream->_count) {
+		return;
+	}
+
+	/* Single buffer playback is over */
+	if (!stream->_cb) {
+		counter_stop(dev);
+		k_sem_give(&stream->_done);
+		return;
+	}
+
+	half = (stream->_pos == stream->_count) ? 0 : 1;
+	if (half) {
+		stream->_pos = 0;
+	}
+
+	/* The half that plays next has not been refilled yet */
+	if (atomic_test_bit(&stream->_pending, !half)) {
+		stream->_underruns++;
+	}
+
+	atomic_set_bit(&stream->_pending, half);
+	k_work_submit(&stream->_refill.work);
+}
+
+void arduino::DacStream::refill(struct k_work *work) {
+	struct refill_work *refill = CONTAINER_OF(work, struct refill_work, work);
+	DacStream *stream = refill->stream;
+
+	for (size_t half = 0; half < 2; half++) {
+		if (atomic_test_bit(&stream->_pending, half)) {
+			stream->_cb(&stream->_buffer[half * stream->_count], stream->_count);
+			atomic_clear_bit(&stream->_pending, half);
+		}
+	}
+}
+
+int analogWriteBuffer(enum dacPins dac, const uint16_t *samples, size_t count,
+					  uint32_t sampleRate) {
+	arduino::DacStream stream(dac);
+
+	return stream.play(sampleRate, samples, count);
+}
+
+#endif
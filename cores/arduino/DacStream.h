@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(CONFIG_DAC) && defined(CONFIG_COUNTER)
+
+namespace arduino {
+
+typedef void (*DacStreamCallback)(uint16_t *samples, size_t count);
+
+/*
+ * Plays samples on a DAC channel at a fixed rate, paced by a hardware
+ * counter claimed from the zephyr,user counters property.
+ *
+ * The user buffer is split in two halves. Each time one half has been
+ * played, the callback is asked to refill it from the system work queue
+ * while the other half plays. If playback reaches a half that is still
+ * waiting for its refill, the stale samples are played again and the
+ * event is counted in underruns().
+ *
+ * Samples are raw values at the DAC resolution set in devicetree. They
+ * are written from the counter interrupt, so the DAC driver must allow
+ * dac_write_value() from ISR context (true for on-chip DACs).
+ */
+class DacStream {
+public:
+	DacStream(enum dacPins dac);
+	~DacStream() {
+		end();
+	}
+
+	/*
+	 * Start playback. `buffer` must hold 2 * `count` samples; both halves
+	 * are filled by calling `cb` before the first sample goes out.
+	 */
+	int begin(uint32_t sampleRate, uint16_t *buffer, size_t count, DacStreamCallback cb);
+	void end();
+
+	/* Play `count` samples once and return when the last one is out */
+	int play(uint32_t sampleRate, const uint16_t *samples, size_t count);
+
+	uint32_t underruns() const {
+		return _underruns;
+	}
+
+private:
+	int start(uint32_t sampleRate, const uint16_t *samples, size_t count);
+	static void counterTop(const struct device *dev, void *user_data);
+	static void refill(struct k_work *work);
+
+	struct refill_work {
+		struct k_work work;
+		DacStream *stream;
+	};
+
+	enum dacPins _dac;
+	const struct device *_dev = nullptr;
+	const struct device *_counter = nullptr;
+	const struct dac_channel_cfg *_cfg = nullptr;
+	const uint16_t *_samples = nullptr;
+	uint16_t *_buffer = nullptr;
+	size_t _count = 0;
+	size_t _pos = 0;
+	DacStreamCallback _cb = nullptr;
+	atomic_t _pending = ATOMIC_INIT(0);
+	uint32_t _underruns = 0;
+	struct refill_work _refill;
+	struct k_sem _done;
+};
+
+} // namespace arduino
+
+using arduino::DacStream;
+
+/* Play a buffer of raw samples on a DAC channel, blocking until done */
+int analogWriteBuffer(enum dacPins dac, const uint16_t *samples, size_t count,
+					  uint32_t sampleRate);
+
+#endif
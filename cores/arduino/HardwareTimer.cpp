@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "HardwareTimer.h"
+#include "zephyrInternal.h"
+#include <zephyr/drivers/counter.h>
+
+#ifdef CONFIG_COUNTER
+
+arduino::HardwareTimer::HardwareTimer() {
+}
+
+int arduino::HardwareTimer::begin() {
+	if (_counter) {
+		return 0;
+	}
+
+	_counter = counterAcquire();
+	return _counter ? 0 : -ENODEV;
+}
+
+void arduino::HardwareTimer::end() {
+	if (!_counter) {
+		return;
+	}
+
+	stop();
+	counterRelease(_counter);
+	_counter = nullptr;
+}
+
+int arduino::HardwareTimer::startPeriodic(uint32_t us, voidFuncPtr cb) {
+	return start(us, cb, true);
+}
+
+int arduino::HardwareTimer::startOneShot(uint32_t us, voidFuncPtr cb) {
+	return start(us, cb, false);
+}
+
+void arduino::HardwareTimer::stop() {
+	if (_counter) {
+		counter_stop(_counter);
+	}
+}
+
+uint32_t arduino::HardwareTimer::averageJitter() const {
+	return _samples ? (uint32_t)(_jitter_sum / _samples) : 0;
+}
+
+void arduino::HardwareTimer::resetStatistics() {
+	unsigned int key = irq_lock();
+
+	_samples = 0;
+	_jitter_min = INT32_MAX;
+	_jitter_max = INT32_MIN;
+	_jitter_sum = 0;
+
+	irq_unlock(key);
+}
+
+int arduino::HardwareTimer::start(uint32_t us, voidFuncPtr cb, bool periodic) {
+	struct counter_top_cfg top_cfg = {};
+	uint64_t ticks;
+	int err;
+
+	if (!_counter) {
+		return -ENODEV;
+	}
+
+	if (!cb || us == 0) {
+		return -EINVAL;
+	}
+
+	/* counter_us_to_ticks() truncates to 32 bits, long periods on fast counters would wrap */
+	ticks = (uint64_t)us * counter_get_frequency(_counter) / USEC_PER_SEC;
+	if (ticks == 0 || ticks > counter_get_max_top_value(_counter)) {
+		return -ERANGE;
+	}
+
+	counter_stop(_counter);
+
+	_cb = cb;
+	_periodic = periodic;
+	_count = 0;
+	_period_cycles =
+		(uint32_t)(ticks * sys_clock_hw_cycles_per_sec() / counter_get_frequency(_counter));
+	resetStatistics();
+
+	top_cfg.ticks = (uint32_t)ticks;
+	top_cfg.callback = topHandler;
+	top_cfg.user_data = this;
+
+	err = counter_set_top_value(_counter, &top_cfg);
+	if (err < 0) {
+		return err;
+	}
+
+	_last_cycles = k_cycle_get_32();
+	return counter_start(_counter);
+}
+
+void arduino::HardwareTimer::topHandler(const struct device *dev, void *user_data) {
+	HardwareTimer *timer = static_cast<HardwareTimer *>(user_data);
+	uint32_t now = k_cycle_get_32();
+
+	timer->_count++;
+
+	if (!timer->_periodic) {
+		counter_stop(dev);
+	} else {
+		int32_t jitter = (int32_t)(now - timer->_last_cycles - timer->_period_cycles);
+
+		timer->_last_cycles = now;
+		timer->_samples++;
+		timer->_jitter_sum += (jitter < 0) ? -jitter : jitter;
+		if (jitter < timer->_jitter_min) {
+			timer->_jitter_min = jitter;
+		}
+		if (jitter > timer->_jitter_max) {
+			timer->_jitter_max = jitter;
+		}
+	}
+
+	timer->_cb();
+	wake(LOOP_EVENT_TIMER);
+}
+
+#endif // CONFIG_COUNTER
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef CONFIG_COUNTER
+
+namespace arduino {
+
+/*
+ * Periodic and one-shot callbacks from a hardware counter.
+ *
+ * begin() claims a free counter from the zephyr,user counters property.
+ * Callbacks run in interrupt context, paced by the counter top value, so
+ * they are not bound to the kernel tick like k_timer.
+ *
+ * Every periodic expiration is timestamped with the CPU cycle counter and
+ * compared with the programmed period to gather jitter statistics, in
+ * CPU cycles.
+ */
+class HardwareTimer {
+public:
+	HardwareTimer();
+	~HardwareTimer() {
+		end();
+	}
+
+	int begin();
+	void end();
+
+	int startPeriodic(uint32_t us, voidFuncPtr cb);
+	int startOneShot(uint32_t us, voidFuncPtr cb);
+	void stop();
+
+	/* Number of expirations since the timer was started */
+	uint32_t count() const {
+		return _count;
+	}
+
+	/* Signed deviation from the programmed period, 0 before the first sample */
+	int32_t minJitter() const {
+		return _samples ? _jitter_min : 0;
+	}
+
+	int32_t maxJitter() const {
+		return _samples ? _jitter_max : 0;
+	}
+
+	/* Mean absolute deviation from the programmed period */
+	uint32_t averageJitter() const;
+
+	void resetStatistics();
+
+private:
+	int start(uint32_t us, voidFuncPtr cb, bool periodic);
+	static void topHandler(const struct device *dev, void *user_data);
+
+	const struct device *_counter = nullptr;
+	voidFuncPtr _cb = nullptr;
+	bool _periodic = false;
+	uint32_t _period_cycles = 0;
+	uint32_t _last_cycles = 0;
+	uint32_t _count = 0;
+	uint32_t _samples = 0;
+	int32_t _jitter_min = 0;
+	int32_t _jitter_max = 0;
+	uint64_t _jitter_sum = 0;
+};
+
+} // namespace arduino
+
+using arduino::HardwareTimer;
+
+#endif // CONFIG_COUNTER
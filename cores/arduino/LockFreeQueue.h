@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * Bounded lock-free queues for handing data from interrupts to threads.
+ *
+ * SpscQueue has exactly one producer and one consumer, for example a UART
+ * interrupt and the thread reading from it. MpscQueue accepts any number of
+ * producers, threads or interrupts, and one consumer.
+ *
+ * Neither queue blocks nor masks interrupts: a full queue rejects the push
+ * and an empty one the pop. Pair them with a semaphore or k_event if the
+ * consumer needs to sleep. Indices run freely and wrap through the
+ * power-of-two size, and the producer and consumer sides are kept on
+ * separate cache lines so that they do not invalidate each other.
+ */
+
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define ARDUINO_CACHE_LINE_SIZE CONFIG_DCACHE_LINE_SIZE
+#else
+#define ARDUINO_CACHE_LINE_SIZE 32
+#endif
+
+namespace arduino {
+
+template <typename T, size_t N> class SpscQueue {
+	static_assert(N > 0 && (N & (N - 1)) == 0, "Queue size must be a power of two");
+	static_assert(__is_trivially_copyable(T), "Queue items are copied with memcpy");
+
+public:
+	bool push(const T &item) {
+		return push(&item, 1) == 1;
+	}
+
+	bool pop(T &item) {
+		return pop(&item, 1) == 1;
+	}
+
+	/* Producer side: copies as many items as fit, returns how many */
+	size_t push(const T *items, size_t count) {
+		size_t done = 0;
+
+		while (done < count) {
+			size_t n = count - done;
+			T *slots = claim(n);
+
+			if (!slots) {
+				break;
+			}
+
+			memcpy(slots, &items[done], n * sizeof(T));
+			commit(n);
+			done += n;
+		}
+
+		return done;
+	}
+
+	/* Consumer side: copies up to count items out, returns how many */
+	size_t pop(T *items, size_t count) {
+		size_t done = 0;
+
+		while (done < count) {
+			size_t n = count - done;
+			const T *slots = peek(n);
+
+			if (!slots) {
+				break;
+			}
+
+			memcpy(&items[done], slots, n * sizeof(T));
+			release(n);
+			done += n;
+		}
+
+		return done;
+	}
+
+	/*
+	 * Producer side, zero copy: returns contiguous free slots and lowers
+	 * count to how many there are, or nullptr when full. The slots become
+	 * visible to the consumer once commit() is called.
+	 */
+	T *claim(size_t &count) {
+		uint32_t head = _head;
+		size_t free = N - (head - _tail_cache);
+
+		if (free < count) {
+			_tail_cache = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+			free = N - (head - _tail_cache);
+		}
+
+		count = min3(count, free, N - (head & (N - 1)));
+		return count ? &_items[head & (N - 1)] : nullptr;
+	}
+
+	void commit(size_t count) {
+		__atomic_store_n(&_head, _head + count, __ATOMIC_RELEASE);
+	}
+
+	/* Consumer side, zero copy: contiguous filled slots, freed by release() */
+	const T *peek(size_t &count) {
+		uint32_t tail = _tail;
+		size_t used = _head_cache - tail;
+
+		if (used < count) {
+			_head_cache = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+			used = _head_cache - tail;
+		}
+
+		count = min3(count, used, N - (tail & (N - 1)));
+		return count ? &_items[tail & (N - 1)] : nullptr;
+	}
+
+	void release(size_t count) {
+		__atomic_store_n(&_tail, _tail + count, __ATOMIC_RELEASE);
+	}
+
+	size_t available() const {
+		return __atomic_load_n(&_head, __ATOMIC_ACQUIRE) - __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+	}
+
+	size_t space() const {
+		return N - available();
+	}
+
+	bool empty() const {
+		return available() == 0;
+	}
+
+private:
+	static size_t min3(size_t a, size_t b, size_t c) {
+		return (a < b) ? ((a < c) ? a : c) : ((b < c) ? b : c);
+	}
+
+	/* Written by the producer, with its last view of the consumer index */
+	alignas(ARDUINO_CACHE_LINE_SIZE) uint32_t _head = 0;
+	uint32_t _tail_cache = 0;
+	/* Written by the consumer, with its last view of the producer index */
+	alignas(ARDUINO_CACHE_LINE_SIZE) uint32_t _tail = 0;
+	uint32_t _head_cache = 0;
+	alignas(ARDUINO_CACHE_LINE_SIZE) T _items[N];
+};
+
+/*
+ * Each slot carries a sequence number telling whether it is free for the
+ * lap of the producer index or filled for the lap of the consumer index.
+ * Producers reserve slots with a compare-and-swap on the head and publish
+ * each one by bumping its sequence, so the consumer only sees completed
+ * items, in reservation order. A producer preempted between reserving and
+ * publishing holds back the items behind it until it resumes.
+ */
+template <typename T, size_t N> class MpscQueue {
+	static_assert(N > 0 && (N & (N - 1)) == 0, "Queue size must be a power of two");
+	static_assert(__is_trivially_copyable(T), "Queue items are copied with memcpy");
+
+public:
+	MpscQueue() {
+		for (uint32_t i = 0; i < N; i++) {
+			_slots[i].seq = i;
+		}
+	}
+
+	bool push(const T &item) {
+		return push(&item, 1) == 1;
+	}
+
+	/* Any producer: pushes all items or none, returns how many */
+	size_t push(const T *items, size_t count) {
+		uint32_t pos;
+
+		if (count == 0 || count > N || !reserve(count, pos)) {
+			return 0;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			struct slot *slot = &_slots[(pos + i) & (N - 1)];
+
+			slot->item = items[i];
+			__atomic_store_n(&slot->seq, pos + i + 1, __ATOMIC_RELEASE);
+		}
+
+		return count;
+	}
+
+	/* Any producer, zero copy: reserves one slot, or returns nullptr when full */
+	T *claim() {
+		uint32_t pos;
+
+		return reserve(1, pos) ? &_slots[pos & (N - 1)].item : nullptr;
+	}
+
+	/* Publishes a slot returned by claim() */
+	void commit(T *item) {
+		struct slot *slot = reinterpret_cast<struct slot *>(reinterpret_cast<char *>(item) -
+														   offsetof(struct slot, item));
+
+		/* The slot belongs to this producer until published, so seq is stable */
+		__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+	}
+
+	/* Consumer only */
+	bool pop(T &item) {
+		const T *front = peek();
+
+		if (!front) {
+			return false;
+		}
+
+		item = *front;
+		release();
+		return true;
+	}
+
+	size_t pop(T *items, size_t count) {
+		size_t done = 0;
+
+		while (done < count && pop(items[done])) {
+			done++;
+		}
+
+		return done;
+	}
+
+	/* Consumer only, zero copy: oldest item, freed by release() */
+	const T *peek() {
+		struct slot *slot = &_slots[_tail & (N - 1)];
+
+		if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != _tail + 1) {
+			return nullptr;
+		}
+
+		return &slot->item;
+	}
+
+	void release() {
+		struct slot *slot = &_slots[_tail & (N - 1)];
+
+		__atomic_store_n(&slot->seq, _tail + N, __ATOMIC_RELEASE);
+		_tail++;
+	}
+
+	bool empty() {
+		return peek() == nullptr;
+	}
+
+private:
+	struct slot {
+		uint32_t seq;
+		T item;
+	};
+
+	bool reserve(size_t count, uint32_t &pos) {
+		pos = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+
+		for (;;) {
+			/* Slots are freed in order, so the last one being free covers the others */
+			struct slot *last = &_slots[(pos + count - 1) & (N - 1)];
+			int32_t diff =
+				(int32_t)(__atomic_load_n(&last->seq, __ATOMIC_ACQUIRE) - (pos + count - 1));
+
+			if (diff < 0) {
+				return false;
+			}
+
+			if (diff == 0 && __atomic_compare_exchange_n(&_head, &pos, pos + count, true,
+														 __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				return true;
+			}
+
+			/* Another producer moved on, the failed exchange reloaded pos */
+			if (diff > 0) {
+				pos = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+			}
+		}
+	}
+
+	alignas(ARDUINO_CACHE_LINE_SIZE) uint32_t _head = 0;
+	alignas(ARDUINO_CACHE_LINE_SIZE) uint32_t _tail = 0;
+	alignas(ARDUINO_CACHE_LINE_SIZE) struct slot _slots[N];
+};
+
+} // namespace arduino
+
+using arduino::MpscQueue;
+using arduino::SpscQueue;
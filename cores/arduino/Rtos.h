@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef CONFIG_MULTITHREADING
+
+/*
+ * Thin wrappers around Zephyr kernel objects for sketches and libraries.
+ *
+ * All storage lives inside the objects, so they can be declared globally
+ * or as class members without touching the heap. Timeouts are in
+ * milliseconds, with rtos::Forever to wait indefinitely. Calls that post
+ * (Semaphore::release, Queue::post, EventFlags::set) are safe from
+ * interrupts; from an interrupt they never wait, whatever the timeout.
+ */
+namespace arduino {
+namespace rtos {
+
+static const unsigned long Forever = (unsigned long)-1;
+
+static inline k_timeout_t timeout(unsigned long ms) {
+	if (k_is_in_isr() || ms == 0) {
+		return K_NO_WAIT;
+	}
+
+	return (ms == Forever) ? K_FOREVER : K_MSEC(ms);
+}
+
+/* Recursive mutex with priority inheritance. Not usable from interrupts. */
+class Mutex {
+public:
+	Mutex() {
+		k_mutex_init(&_mutex);
+	}
+
+	Mutex(const Mutex &) = delete;
+	Mutex &operator=(const Mutex &) = delete;
+
+	bool lock(unsigned long ms = Forever) {
+		return k_mutex_lock(&_mutex, timeout(ms)) == 0;
+	}
+
+	bool trylock() {
+		return lock(0);
+	}
+
+	void unlock() {
+		k_mutex_unlock(&_mutex);
+	}
+
+	struct k_mutex *native() {
+		return &_mutex;
+	}
+
+private:
+	struct k_mutex _mutex;
+};
+
+/* Holds a Mutex for the lifetime of the scope */
+class ScopedLock {
+public:
+	explicit ScopedLock(Mutex &mutex) : _mutex(mutex) {
+		_mutex.lock();
+	}
+
+	~ScopedLock() {
+		_mutex.unlock();
+	}
+
+	ScopedLock(const ScopedLock &) = delete;
+	ScopedLock &operator=(const ScopedLock &) = delete;
+
+private:
+	Mutex &_mutex;
+};
+
+class Semaphore {
+public:
+	explicit Semaphore(unsigned int count = 0, unsigned int limit = K_SEM_MAX_LIMIT) {
+		k_sem_init(&_sem, count, limit);
+	}
+
+	Semaphore(const Semaphore &) = delete;
+	Semaphore &operator=(const Semaphore &) = delete;
+
+	bool acquire(unsigned long ms = Forever) {
+		return k_sem_take(&_sem, timeout(ms)) == 0;
+	}
+
+	void release() {
+		k_sem_give(&_sem);
+	}
+
+	unsigned int count() {
+		return k_sem_count_get(&_sem);
+	}
+
+	struct k_sem *native() {
+		return &_sem;
+	}
+
+private:
+	struct k_sem _sem;
+};
+
+/* Fixed size queue of N messages of type T, copied in and out by value */
+template <typename T, size_t N> class Queue {
+	static_assert(__is_trivially_copyable(T), "Queue messages are copied with memcpy");
+	static_assert(N > 0, "Queue needs room for at least one message");
+
+public:
+	Queue() {
+		k_msgq_init(&_msgq, _buffer, sizeof(T), N);
+	}
+
+	Queue(const Queue &) = delete;
+	Queue &operator=(const Queue &) = delete;
+
+	bool post(const T &msg, unsigned long ms = 0) {
+		return k_msgq_put(&_msgq, &msg, timeout(ms)) == 0;
+	}
+
+	bool get(T &msg, unsigned long ms = Forever) {
+		return k_msgq_get(&_msgq, &msg, timeout(ms)) == 0;
+	}
+
+	bool peek(T &msg) {
+		return k_msgq_peek(&_msgq, &msg) == 0;
+	}
+
+	size_t available() {
+		return k_msgq_num_used_get(&_msgq);
+	}
+
+	size_t space() {
+		return k_msgq_num_free_get(&_msgq);
+	}
+
+	void clear() {
+		k_msgq_purge(&_msgq);
+	}
+
+	struct k_msgq *native() {
+		return &_msgq;
+	}
+
+private:
+	struct k_msgq _msgq;
+	char __aligned(alignof(T) > 4 ? alignof(T) : 4) _buffer[sizeof(T) * N];
+};
+
+#ifdef CONFIG_EVENTS
+
+/* 32 event bits that threads can wait on, any or all of them at once */
+class EventFlags {
+public:
+	EventFlags() {
+		k_event_init(&_event);
+	}
+
+	EventFlags(const EventFlags &) = delete;
+	EventFlags &operator=(const EventFlags &) = delete;
+
+	void set(uint32_t flags) {
+		k_event_post(&_event, flags);
+	}
+
+	void clear(uint32_t flags) {
+		k_event_clear(&_event, flags);
+	}
+
+	uint32_t get() {
+		return k_event_test(&_event, UINT32_MAX);
+	}
+
+	/* Returns the flags that ended the wait, 0 on timeout. Matched flags are cleared. */
+	uint32_t waitAny(uint32_t flags, unsigned long ms = Forever) {
+		uint32_t events = k_event_wait(&_event, flags, false, timeout(ms));
+
+		k_event_clear(&_event, events);
+		return events;
+	}
+
+	uint32_t waitAll(uint32_t flags, unsigned long ms = Forever) {
+		uint32_t events = k_event_wait_all(&_event, flags, false, timeout(ms));
+
+		k_event_clear(&_event, events);
+		return events;
+	}
+
+	struct k_event *native() {
+		return &_event;
+	}
+
+private:
+	struct k_event _event;
+};
+
+#endif // CONFIG_EVENTS
+
+} // namespace rtos
+} // namespace arduino
+
+namespace rtos = arduino::rtos;
+
+#endif // CONFIG_MULTITHREADING
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Scheduler.h"
+
+#ifdef CONFIG_MULTITHREADING
+
+namespace {
+
+K_KERNEL_STACK_ARRAY_DEFINE(loop_stacks, CONFIG_ARDUINO_SCHEDULER_LOOPS,
+							CONFIG_ARDUINO_SCHEDULER_STACK_SIZE);
+
+struct loop_slot {
+	struct k_thread thread;
+	voidFuncPtr loop;
+	uint64_t last_cycles;
+	uint64_t last_all_cycles;
+} loop_slots[CONFIG_ARDUINO_SCHEDULER_LOOPS];
+
+atomic_t loop_slots_used;
+
+void loop_entry(void *p1, void *p2, void *p3) {
+	struct loop_slot *slot = static_cast<struct loop_slot *>(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		slot->loop();
+	}
+}
+
+struct loop_slot *loop_slot_get(int id) {
+	if (id < 0 || id >= CONFIG_ARDUINO_SCHEDULER_LOOPS || !atomic_test_bit(&loop_slots_used, id)) {
+		return nullptr;
+	}
+
+	return &loop_slots[id];
+}
+
+} // anonymous namespace
+
+arduino::SchedulerClass arduino::Scheduler;
+
+int arduino::SchedulerClass::startLoop(voidFuncPtr loop, size_t stackSize, int priority) {
+	struct loop_slot *slot;
+	int id;
+
+	if (!loop) {
+		return -EINVAL;
+	}
+
+	if (stackSize == 0) {
+		stackSize = CONFIG_ARDUINO_SCHEDULER_STACK_SIZE;
+	}
+
+	if (stackSize > K_KERNEL_STACK_SIZEOF(loop_stacks[0])) {
+		return -ENOMEM;
+	}
+
+	for (id = 0; id < CONFIG_ARDUINO_SCHEDULER_LOOPS; id++) {
+		if (!atomic_test_and_set_bit(&loop_slots_used, id)) {
+			break;
+		}
+	}
+
+	if (id == CONFIG_ARDUINO_SCHEDULER_LOOPS) {
+		return -EBUSY;
+	}
+
+	slot = &loop_slots[id];
+	slot->loop = loop;
+	slot->last_cycles = 0;
+	slot->last_all_cycles = 0;
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	k_thread_runtime_stats_t all;
+
+	if (k_thread_runtime_stats_all_get(&all) == 0) {
+		slot->last_all_cycles = all.execution_cycles;
+	}
+#endif
+
+	k_thread_create(&slot->thread, loop_stacks[id], stackSize, loop_entry, slot, NULL, NULL,
+					priority, 0, K_NO_WAIT);
+	k_thread_name_set(&slot->thread, "loop");
+
+	return id;
+}
+
+int arduino::SchedulerClass::stopLoop(int id) {
+	struct loop_slot *slot = loop_slot_get(id);
+
+	if (!slot) {
+		return -EINVAL;
+	}
+
+	if (&slot->thread == k_current_get()) {
+		/*
+		 * Aborting the current thread does not return, so the slot has to
+		 * be freed first. The scheduler lock dies with the thread and keeps
+		 * startLoop() from reusing the slot before the abort is complete.
+		 */
+		k_sched_lock();
+		atomic_clear_bit(&loop_slots_used, id);
+		k_thread_abort(k_current_get());
+	}
+
+	k_thread_abort(&slot->thread);
+	atomic_clear_bit(&loop_slots_used, id);
+
+	return 0;
+}
+
+uint64_t arduino::SchedulerClass::cpuCycles(int id) {
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	struct loop_slot *slot = loop_slot_get(id);
+	k_thread_runtime_stats_t stats;
+
+	if (!slot || k_thread_runtime_stats_get(&slot->thread, &stats) < 0) {
+		return 0;
+	}
+
+	return stats.execution_cycles;
+#else
+	ARG_UNUSED(id);
+	return 0;
+#endif
+}
+
+unsigned int arduino::SchedulerClass::cpuUsage(int id) {
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	struct loop_slot *slot = loop_slot_get(id);
+	k_thread_runtime_stats_t stats, all;
+	uint64_t busy, elapsed;
+
+	if (!slot || k_thread_runtime_stats_get(&slot->thread, &stats) < 0 ||
+		k_thread_runtime_stats_all_get(&all) < 0) {
+		return 0;
+	}
+
+	/* execution_cycles of all threads includes the idle thread, so it is the elapsed time */
+	busy = stats.execution_cycles - slot->last_cycles;
+	elapsed = all.execution_cycles - slot->last_all_cycles;
+	slot->last_cycles = stats.execution_cycles;
+	slot->last_all_cycles = all.execution_cycles;
+
+	return elapsed ? (unsigned int)(busy * 100 / elapsed) : 0;
+#else
+	ARG_UNUSED(id);
+	return 0;
+#endif
+}
+
+#endif // CONFIG_MULTITHREADING
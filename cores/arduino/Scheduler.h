@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef CONFIG_MULTITHREADING
+
+namespace arduino {
+
+/*
+ * Runs extra loop() style functions in their own threads.
+ *
+ * Each loop gets a thread and a stack from a static pool sized by
+ * ARDUINO_SCHEDULER_LOOPS and ARDUINO_SCHEDULER_STACK_SIZE, and calls its
+ * function over and over. Loops at the same priority as loop() share the
+ * CPU whenever one of them blocks, for example in delay(); a lower number
+ * is a higher priority and preempts loop().
+ *
+ * With CONFIG_ARDUINO_SCHEDULER_CPU_USAGE the CPU time spent in each loop
+ * is tracked and reported by cpuCycles() and cpuUsage().
+ */
+class SchedulerClass {
+public:
+	/* Returns the loop id, or a negative error code */
+	int startLoop(voidFuncPtr loop, size_t stackSize = 0,
+				  int priority = CONFIG_MAIN_THREAD_PRIORITY);
+	int stopLoop(int id);
+
+	void yield() {
+		k_yield();
+	}
+
+	/* CPU cycles spent in the loop since it was started */
+	uint64_t cpuCycles(int id);
+	/* Share of the CPU used by the loop since the previous call, in percent */
+	unsigned int cpuUsage(int id);
+};
+
+extern SchedulerClass Scheduler;
+
+} // namespace arduino
+
+using arduino::Scheduler;
+
+#endif // CONFIG_MULTITHREADING
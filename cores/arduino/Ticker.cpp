@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Ticker.h"
+
+#ifdef CONFIG_MULTITHREADING
+
+namespace {
+
+K_KERNEL_STACK_DEFINE(ticker_stack, CONFIG_ARDUINO_TICKER_STACK_SIZE);
+struct k_work_q ticker_workq;
+bool ticker_workq_started;
+
+/* The queue thread is only created once a ticker is actually used */
+void ticker_workq_start() {
+	struct k_work_queue_config cfg = {};
+
+	k_sched_lock();
+	if (!ticker_workq_started) {
+		cfg.name = "ticker";
+		k_work_queue_init(&ticker_workq);
+		k_work_queue_start(&ticker_workq, ticker_stack, K_KERNEL_STACK_SIZEOF(ticker_stack),
+						   CONFIG_ARDUINO_TICKER_PRIORITY, &cfg);
+		ticker_workq_started = true;
+	}
+	k_sched_unlock();
+}
+
+} // anonymous namespace
+
+arduino::Ticker::Ticker() {
+	k_timer_init(&_timer, expired, NULL);
+	k_timer_user_data_set(&_timer, this);
+	k_work_init(&_work, run);
+}
+
+arduino::Ticker::~Ticker() {
+	struct k_work_sync sync;
+
+	k_timer_stop(&_timer);
+	k_work_cancel_sync(&_work, &sync);
+}
+
+void arduino::Ticker::attach(unsigned long ms, voidFuncPtr cb) {
+	attach(ms, callVoid, (void *)cb);
+}
+
+void arduino::Ticker::attach(unsigned long ms, voidFuncPtrParam cb, void *arg) {
+	start(K_MSEC(ms), true, cb, arg);
+}
+
+void arduino::Ticker::attachMicros(unsigned long us, voidFuncPtr cb) {
+	attachMicros(us, callVoid, (void *)cb);
+}
+
+void arduino::Ticker::attachMicros(unsigned long us, voidFuncPtrParam cb, void *arg) {
+	start(K_USEC(us), true, cb, arg);
+}
+
+void arduino::Ticker::once(unsigned long ms, voidFuncPtr cb) {
+	once(ms, callVoid, (void *)cb);
+}
+
+void arduino::Ticker::once(unsigned long ms, voidFuncPtrParam cb, void *arg) {
+	start(K_MSEC(ms), false, cb, arg);
+}
+
+void arduino::Ticker::detach() {
+	k_timer_stop(&_timer);
+	k_work_cancel(&_work);
+}
+
+bool arduino::Ticker::active() const {
+	return k_timer_remaining_ticks(&_timer) != 0;
+}
+
+void arduino::Ticker::start(k_timeout_t period, bool periodic, voidFuncPtrParam cb, void *arg) {
+	ticker_workq_start();
+
+	detach();
+	_cb = cb;
+	_arg = arg;
+	_overruns = 0;
+	k_timer_start(&_timer, period, periodic ? period : K_NO_WAIT);
+}
+
+void arduino::Ticker::expired(struct k_timer *timer) {
+	Ticker *ticker = static_cast<Ticker *>(k_timer_user_data_get(timer));
+
+	/* Returns 0 when the previous expiration is still queued */
+	if (k_work_submit_to_queue(&ticker_workq, &ticker->_work) == 0) {
+		ticker->_overruns++;
+	}
+}
+
+void arduino::Ticker::run(struct k_work *work) {
+	Ticker *ticker = CONTAINER_OF(work, Ticker, _work);
+
+	ticker->_cb(ticker->_arg);
+	wake(LOOP_EVENT_TIMER);
+}
+
+void arduino::Ticker::callVoid(void *arg) {
+	((voidFuncPtr)arg)();
+}
+
+#endif // CONFIG_MULTITHREADING
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef CONFIG_MULTITHREADING
+
+namespace arduino {
+
+/*
+ * Periodic or one-shot callbacks in thread context.
+ *
+ * Expirations are counted by a k_timer, which reloads from the scheduled
+ * expiry rather than from when the callback ran, so the period does not
+ * drift. Each expiration submits a work item to a work queue shared by all
+ * tickers, so callbacks may block and use Serial, Wire or SPI.
+ *
+ * If the previous callback of the same ticker has not run yet when the
+ * timer fires again, the expirations are merged and counted in overruns().
+ *
+ * Ticker objects hold all of their state and can be declared globally.
+ */
+class Ticker {
+public:
+	Ticker();
+	/* Waits for a running callback, so it must not delete its own ticker */
+	~Ticker();
+
+	void attach(unsigned long ms, voidFuncPtr cb);
+	void attach(unsigned long ms, voidFuncPtrParam cb, void *arg);
+	void attachMicros(unsigned long us, voidFuncPtr cb);
+	void attachMicros(unsigned long us, voidFuncPtrParam cb, void *arg);
+
+	void once(unsigned long ms, voidFuncPtr cb);
+	void once(unsigned long ms, voidFuncPtrParam cb, void *arg);
+
+	/* May be called from the ticker's own callback */
+	void detach();
+
+	bool active() const;
+
+	uint32_t overruns() const {
+		return _overruns;
+	}
+
+private:
+	void start(k_timeout_t period, bool periodic, voidFuncPtrParam cb, void *arg);
+	static void expired(struct k_timer *timer);
+	static void run(struct k_work *work);
+	static void callVoid(void *arg);
+
+	struct k_timer _timer;
+	struct k_work _work;
+	voidFuncPtrParam _cb = nullptr;
+	void *_arg = nullptr;
+	uint32_t _overruns = 0;
+};
+
+} // namespace arduino
+
+using arduino::Ticker;
+
+#endif // CONFIG_MULTITHREADING
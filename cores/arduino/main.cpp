@@ -5,6 +5,7 @@
  */
 
 #include "Arduino.h"
+#include "zephyrInternal.h"
 #include "zephyr/kernel.h"
 #include <cstdint>
 #ifdef CONFIG_LLEXT
@@ -44,6 +45,7 @@ int main(void) {
     if (arduino::serialEventRun) arduino::serialEventRun();
 #endif
 		__loopHook();
+		loopWait();
 	}
 
 	return 0;
@@ -6,6 +6,7 @@
 
 #include <Arduino.h>
 #include "zephyrInternal.h"
+#include <zephyr/random/random.h>
 
 static const struct gpio_dt_spec arduino_pins[] = {
 	DT_FOREACH_PROP_ELEM_SEP(
@@ -70,6 +71,46 @@ const int max_ngpios = 0;
 
 #endif
 
+/*
+ * Build pin number to table index lookups at compile time, so that
+ * hot paths do not have to scan the devicetree derived tables.
+ */
+
+#define PIN_INDEX_NONE 0xFF
+
+constexpr uint8_t pin_table_index(const pin_size_t *table, size_t len, pin_size_t pin,
+								  size_t i = 0) {
+	return (i >= len) ? PIN_INDEX_NONE :
+		   (table[i] == pin) ? (uint8_t)i :
+							   pin_table_index(table, len, pin, i + 1);
+}
+
+#define DIGITAL_PINS_LEN DT_PROP_LEN_OR(DT_PATH(zephyr_user), digital_pin_gpios, 0)
+
+#if DT_PROP_LEN(DT_PATH(zephyr_user), digital_pin_gpios) > 0
+
+/* Devicetree ordinal of the GPIO controller of each digital pin */
+#define GPIO_PORT_ORD(n, p, i) DT_DEP_ORD(DT_GPIO_CTLR_BY_IDX(n, p, i))
+constexpr uint32_t arduino_port_ords[] = {
+	DT_FOREACH_PROP_ELEM_SEP(DT_PATH(zephyr_user), digital_pin_gpios, GPIO_PORT_ORD, (, ))};
+
+/* Index of the first digital pin that shares the GPIO controller of pin 'i' */
+constexpr size_t first_pin_on_port(size_t i, size_t j = 0) {
+	return (arduino_port_ords[j] == arduino_port_ords[i]) ? j : first_pin_on_port(i, j + 1);
+}
+
+/* Number of distinct GPIO controllers among pins [0, 'end') */
+constexpr size_t ports_before(size_t end, size_t k = 0) {
+	return (k >= end) ? 0 : ((first_pin_on_port(k) == k) ? 1 : 0) + ports_before(end, k + 1);
+}
+
+/* Slots are numbered by order of first appearance, like port_callback[] */
+#define PORT_SLOT(i, _) (uint8_t) ports_before(first_pin_on_port(i))
+constexpr uint8_t arduino_port_slot[] = {LISTIFY(DIGITAL_PINS_LEN, PORT_SLOT, (, ))};
+static_assert((int)ports_before(DIGITAL_PINS_LEN) == port_num, "port slots do not match port_num");
+
+#endif
+
 /*
  * GPIO callback implementation
  */
@@ -77,6 +118,8 @@ const int max_ngpios = 0;
 struct arduino_callback {
 	voidFuncPtr handler;
 	bool enabled;
+	uint8_t mode;   /* PinStatus passed to attachInterrupt() */
+	uint8_t filter; /* 1-based index in gpio_irq_filters[], 0 if unfiltered */
 };
 
 struct gpio_port_callback {
@@ -86,35 +129,242 @@ struct gpio_port_callback {
 	const struct device *dev;
 } port_callback[port_num] = {0};
 
-struct gpio_port_callback *find_gpio_port_callback(const struct device *dev) {
-	for (size_t i = 0; i < ARRAY_SIZE(port_callback); i++) {
-		if (port_callback[i].dev == dev) {
-			return &port_callback[i];
-		}
-		if (port_callback[i].dev == nullptr) {
-			port_callback[i].dev = dev;
-			return &port_callback[i];
-		}
+struct gpio_port_callback *find_gpio_port_callback(pin_size_t pinNumber) {
+#if DT_PROP_LEN(DT_PATH(zephyr_user), digital_pin_gpios) > 0
+	struct gpio_port_callback *pcb;
+
+	if (pinNumber >= ARRAY_SIZE(arduino_port_slot)) {
+		return nullptr;
 	}
 
+	pcb = &port_callback[arduino_port_slot[pinNumber]];
+	pcb->dev = arduino_pins[pinNumber].port;
+	return pcb;
+#else
+	ARG_UNUSED(pinNumber);
 	return nullptr;
+#endif
 }
 
 void setInterruptHandler(pin_size_t pinNumber, voidFuncPtr func) {
-	struct gpio_port_callback *pcb = find_gpio_port_callback(arduino_pins[pinNumber].port);
+	struct gpio_port_callback *pcb = find_gpio_port_callback(pinNumber);
 
 	if (pcb) {
 		pcb->handlers[arduino_pins[pinNumber].pin].handler = func;
 	}
 }
 
+gpio_flags_t pin_status_to_intmode(uint8_t pinStatus) {
+	switch (pinStatus) {
+	case LOW:
+		return GPIO_INT_LEVEL_LOW;
+	case HIGH:
+		return GPIO_INT_LEVEL_HIGH;
+	case CHANGE:
+		return GPIO_INT_EDGE_BOTH;
+	case FALLING:
+		return GPIO_INT_EDGE_FALLING;
+	case RISING:
+		return GPIO_INT_EDGE_RISING;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Interrupt filters: software debounce and rate limiting
+ *
+ * A filtered pin masks its interrupt on the first edge and starts a
+ * one-shot timer. For debouncing, the timer reads back the level once
+ * the window has elapsed and only calls the handler if it changed in
+ * the direction the pin is attached to. For rate limiting, a pin that
+ * fires more than max_rate times within one second stays masked until
+ * the second is over.
+ */
+
+struct gpio_irq_filter {
+	struct k_timer timer;
+	pin_size_t pin;
+	bool used;
+	bool throttled;
+	int level;
+	uint32_t debounce_us;
+	uint32_t max_rate;
+	uint32_t window_start;
+	uint32_t count;
+	uint32_t throttle_count;
+} gpio_irq_filters[CONFIG_ARDUINO_GPIO_IRQ_FILTERS];
+
+struct arduino_callback *pin_callback(pin_size_t pinNumber) {
+	struct gpio_port_callback *pcb = find_gpio_port_callback(pinNumber);
+
+	return pcb ? &pcb->handlers[arduino_pins[pinNumber].pin] : nullptr;
+}
+
+void gpio_irq_filter_unmask(struct gpio_irq_filter *filter) {
+	struct arduino_callback *cb = pin_callback(filter->pin);
+
+	/* Stay masked if the handler went away in the meantime */
+	if (!cb->handler) {
+		return;
+	}
+
+	gpio_pin_interrupt_configure(arduino_pins[filter->pin].port, arduino_pins[filter->pin].pin,
+								 pin_status_to_intmode(cb->mode));
+}
+
+void gpio_irq_filter_expiry(struct k_timer *timer) {
+	struct gpio_irq_filter *filter = CONTAINER_OF(timer, struct gpio_irq_filter, timer);
+	struct arduino_callback *cb = pin_callback(filter->pin);
+	int level;
+	bool fire;
+
+	if (filter->throttled) {
+		filter->throttled = false;
+		filter->window_start = k_uptime_get_32();
+		filter->count = 0;
+		filter->level = gpio_pin_get_raw(arduino_pins[filter->pin].port,
+										 arduino_pins[filter->pin].pin);
+		gpio_irq_filter_unmask(filter);
+		return;
+	}
+
+	/* Debounce window elapsed, check where the pin settled */
+	level = gpio_pin_get_raw(arduino_pins[filter->pin].port, arduino_pins[filter->pin].pin);
+
+	switch (cb->mode) {
+	case LOW:
+		fire = (level == 0);
+		break;
+	case HIGH:
+		fire = (level == 1);
+		break;
+	case FALLING:
+		fire = (filter->level == 1 && level == 0);
+		break;
+	case RISING:
+		fire = (filter->level == 0 && level == 1);
+		break;
+	default:
+		fire = (filter->level != level);
+		break;
+	}
+
+	filter->level = level;
+	gpio_irq_filter_unmask(filter);
+
+	if (fire && cb->enabled && cb->handler) {
+		cb->handler();
+		wake(LOOP_EVENT_GPIO);
+	}
+}
+
+void gpio_irq_filter_event(struct gpio_irq_filter *filter, struct arduino_callback *cb) {
+	const struct gpio_dt_spec *spec = &arduino_pins[filter->pin];
+
+	if (filter->max_rate) {
+		uint32_t now = k_uptime_get_32();
+
+		if (now - filter->window_start >= MSEC_PER_SEC) {
+			filter->window_start = now;
+			filter->count = 0;
+		}
+
+		if (++filter->count > filter->max_rate) {
+			/* Interrupt storm: keep the pin masked for the rest of the window */
+			gpio_pin_interrupt_configure(spec->port, spec->pin, GPIO_INT_DISABLE);
+			filter->throttled = true;
+			filter->throttle_count++;
+			k_timer_start(&filter->timer, K_MSEC(MSEC_PER_SEC - (now - filter->window_start)),
+						  K_NO_WAIT);
+			return;
+		}
+	}
+
+	if (filter->debounce_us) {
+		gpio_pin_interrupt_configure(spec->port, spec->pin, GPIO_INT_DISABLE);
+		k_timer_start(&filter->timer, K_USEC(filter->debounce_us), K_NO_WAIT);
+		return;
+	}
+
+	cb->handler();
+	wake(LOOP_EVENT_GPIO);
+}
+
+struct gpio_irq_filter *gpio_irq_filter_get(pin_size_t pinNumber) {
+	struct arduino_callback *cb = pin_callback(pinNumber);
+	struct gpio_irq_filter *filter = nullptr;
+	unsigned int key;
+
+	if (!cb) {
+		return nullptr;
+	}
+
+	if (cb->filter) {
+		return &gpio_irq_filters[cb->filter - 1];
+	}
+
+	key = irq_lock();
+	for (size_t i = 0; i < ARRAY_SIZE(gpio_irq_filters); i++) {
+		if (!gpio_irq_filters[i].used) {
+			filter = &gpio_irq_filters[i];
+			memset(filter, 0, sizeof(*filter));
+			filter->used = true;
+			filter->pin = pinNumber;
+			filter->level = gpio_pin_get_raw(arduino_pins[pinNumber].port,
+											 arduino_pins[pinNumber].pin);
+			filter->window_start = k_uptime_get_32();
+			k_timer_init(&filter->timer, gpio_irq_filter_expiry, NULL);
+			cb->filter = i + 1;
+			break;
+		}
+	}
+	irq_unlock(key);
+
+	return filter;
+}
+
+void gpio_irq_filter_release(struct arduino_callback *cb) {
+	struct gpio_irq_filter *filter;
+	unsigned int key;
+
+	if (!cb || !cb->filter) {
+		return;
+	}
+
+	filter = &gpio_irq_filters[cb->filter - 1];
+	k_timer_stop(&filter->timer);
+
+	key = irq_lock();
+	cb->filter = 0;
+	filter->used = false;
+	irq_unlock(key);
+}
+
+void gpio_irq_filter_put(pin_size_t pinNumber, struct gpio_irq_filter *filter) {
+	if (filter->debounce_us || filter->max_rate) {
+		return;
+	}
+
+	gpio_irq_filter_release(pin_callback(pinNumber));
+
+	/* A pending debounce or throttle window may have left the pin masked */
+	gpio_irq_filter_unmask(filter);
+}
+
 void handleGpioCallback(const struct device *port, struct gpio_callback *cb, uint32_t pins) {
 	(void)port; // unused
 	struct gpio_port_callback *pcb = (struct gpio_port_callback *)cb;
 
 	for (uint32_t i = 0; i < max_ngpios; i++) {
 		if (pins & BIT(i) && pcb->handlers[i].enabled) {
-			pcb->handlers[i].handler();
+			if (pcb->handlers[i].filter) {
+				gpio_irq_filter_event(&gpio_irq_filters[pcb->handlers[i].filter - 1],
+									  &pcb->handlers[i]);
+			} else {
+				pcb->handlers[i].handler();
+				wake(LOOP_EVENT_GPIO);
+			}
 		}
 	}
 }
@@ -130,16 +380,51 @@ const struct pwm_dt_spec arduino_pwm[] = {
 	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), pwms, PWM_DT_SPEC)};
 
 /* pwm-pins node provides a mapping digital pin numbers to pwm channels */
-const pin_size_t arduino_pwm_pins[] = {
+constexpr pin_size_t arduino_pwm_pins[] = {
 	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), pwm_pin_gpios, PWM_PINS)};
 
+/* Reverse mapping from digital pin numbers to pwm channels */
+#define PWM_PIN_INDEX(i, _) pin_table_index(arduino_pwm_pins, ARRAY_SIZE(arduino_pwm_pins), i)
+constexpr uint8_t arduino_pwm_index[] = {LISTIFY(DIGITAL_PINS_LEN, PWM_PIN_INDEX, (, ))};
+
 size_t pwm_pin_index(pin_size_t pinNumber) {
-	for (size_t i = 0; i < ARRAY_SIZE(arduino_pwm_pins); i++) {
-		if (arduino_pwm_pins[i] == pinNumber) {
-			return i;
-		}
+	if (pinNumber >= ARRAY_SIZE(arduino_pwm_index) ||
+		arduino_pwm_index[pinNumber] == PIN_INDEX_NONE) {
+		return (size_t)-1;
 	}
-	return (size_t)-1;
+	return arduino_pwm_index[pinNumber];
+}
+
+/*
+ * Period of each pwm channel in cycles, resolved on first use so that
+ * analogWrite() does not convert from nanoseconds on every call.
+ * 0 means the channel has not been set up yet.
+ */
+uint32_t pwm_period_cycles[ARRAY_SIZE(arduino_pwm)];
+
+/* Last pulse written to each channel, kept to re-apply the duty when the period changes */
+uint32_t pwm_pulse[ARRAY_SIZE(arduino_pwm)];
+bool pwm_active[ARRAY_SIZE(arduino_pwm)];
+
+int pwm_channel_setup(size_t idx) {
+	uint64_t cycles_per_sec;
+	int err;
+
+	if (pwm_period_cycles[idx]) {
+		return 0;
+	}
+
+	if (!pwm_is_ready_dt(&arduino_pwm[idx])) {
+		return -ENODEV;
+	}
+
+	err = pwm_get_cycles_per_sec(arduino_pwm[idx].dev, arduino_pwm[idx].channel, &cycles_per_sec);
+	if (err < 0) {
+		return err;
+	}
+
+	pwm_period_cycles[idx] = (uint32_t)(arduino_pwm[idx].period * cycles_per_sec / NSEC_PER_SEC);
+	return pwm_period_cycles[idx] ? 0 : -ENOTSUP;
 }
 
 #endif // CONFIG_PWM
@@ -150,25 +435,34 @@ size_t pwm_pin_index(pin_size_t pinNumber) {
 #define ADC_PINS(n, p, i)                                                                          \
 	DIGITAL_PIN_GPIOS_FIND_PIN(DT_REG_ADDR(DT_PHANDLE_BY_IDX(DT_PATH(zephyr_user), p, i)),         \
 							   DT_PHA_BY_IDX(DT_PATH(zephyr_user), p, i, pin)),
-#define ADC_CH_CFG(n, p, i) arduino_adc[i].channel_cfg,
+#define ADC_CH_CFG(n, p, i)       arduino_adc[i].channel_cfg,
+#define ADC_OVERSAMPLING(n, p, i) arduino_adc[i].oversampling,
 
 static const struct adc_dt_spec arduino_adc[] = {
 	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), io_channels, ADC_DT_SPEC)};
 
 /* io-channel-pins node provides a mapping digital pin numbers to adc channels */
-const pin_size_t arduino_analog_pins[] = {
+constexpr pin_size_t arduino_analog_pins[] = {
 	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), adc_pin_gpios, ADC_PINS)};
 
+/* Reverse mapping from digital pin numbers to adc channels */
+#define ADC_PIN_INDEX(i, _)                                                                        \
+	pin_table_index(arduino_analog_pins, ARRAY_SIZE(arduino_analog_pins), i)
+constexpr uint8_t arduino_analog_index[] = {LISTIFY(DIGITAL_PINS_LEN, ADC_PIN_INDEX, (, ))};
+
 struct adc_channel_cfg channel_cfg[] = {
 	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), io_channels, ADC_CH_CFG)};
 
+/* Hardware oversampling per channel, as log2 of the number of averaged samples */
+uint8_t adc_oversampling[] = {
+	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), io_channels, ADC_OVERSAMPLING)};
+
 size_t analog_pin_index(pin_size_t pinNumber) {
-	for (size_t i = 0; i < ARRAY_SIZE(arduino_analog_pins); i++) {
-		if (arduino_analog_pins[i] == pinNumber) {
-			return i;
-		}
+	if (pinNumber >= ARRAY_SIZE(arduino_analog_index) ||
+		arduino_analog_index[pinNumber] == PIN_INDEX_NONE) {
+		return (size_t)-1;
 	}
-	return (size_t)-1;
+	return arduino_analog_index[pinNumber];
 }
 
 #endif // CONFIG_ADC
@@ -191,10 +485,29 @@ static const struct device *const dac_dev = DEVICE_DT_GET(DAC_NODE);
 static const struct dac_channel_cfg dac_ch_cfg[] = {
 	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), dac_channels, DAC_CHANNEL_DEFINE)};
 
+/* Channels are configured on first use only */
+static bool dac_ch_ready[ARRAY_SIZE(dac_ch_cfg)];
+
 #endif
 
 #endif // CONFIG_DAC
 
+#ifdef CONFIG_COUNTER
+
+#if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), counters)
+
+#define COUNTER_DEVICE(n, p, i) DEVICE_DT_GET(DT_PHANDLE_BY_IDX(n, p, i)),
+
+/* counters node lists the hardware counters sketches and libraries may claim */
+static const struct device *const arduino_counters[] = {
+	DT_FOREACH_PROP_ELEM(DT_PATH(zephyr_user), counters, COUNTER_DEVICE)};
+
+static atomic_t arduino_counters_used;
+
+#endif
+
+#endif // CONFIG_COUNTER
+
 static unsigned int irq_key;
 static bool interrupts_disabled = false;
 } // namespace
@@ -309,6 +622,30 @@ int analogWriteResolution() {
 
 #ifdef CONFIG_PWM
 
+/*
+ * Scale a value in the analogWrite() resolution to a pulse width in cycles.
+ * The full scale is a power of two, so this is a multiply and a shift.
+ */
+static inline uint32_t pwm_pulse_cycles(size_t idx, int value) {
+	uint32_t period = pwm_period_cycles[idx];
+	uint64_t pulse;
+
+	if (value <= 0) {
+		return 0;
+	}
+
+	pulse = ((uint64_t)value * period) >> _analog_write_resolution;
+	return (pulse > period) ? period : (uint32_t)pulse;
+}
+
+static int pwm_channel_write(size_t idx, uint32_t pulse) {
+	pwm_pulse[idx] = pulse;
+	pwm_active[idx] = true;
+
+	return pwm_set_cycles(arduino_pwm[idx].dev, arduino_pwm[idx].channel, pwm_period_cycles[idx],
+						  pulse, arduino_pwm[idx].flags);
+}
+
 void analogWrite(pin_size_t pinNumber, int value) {
 	size_t idx = pwm_pin_index(pinNumber);
 
@@ -316,34 +653,137 @@ void analogWrite(pin_size_t pinNumber, int value) {
 		return;
 	}
 
-	if (!pwm_is_ready_dt(&arduino_pwm[idx])) {
+	if (pwm_channel_setup(idx) < 0) {
 		return;
 	}
 
-	value = map(value, 0, 1 << _analog_write_resolution, 0, arduino_pwm[idx].period);
+	/*
+	 * A duty ratio determines by the period value defined in dts
+	 * and the value arguments. So usually the period value sets as 255.
+	 */
+	(void)pwm_channel_write(idx, pwm_pulse_cycles(idx, value));
+}
 
-	if (((uint32_t)value) > arduino_pwm[idx].period) {
-		value = arduino_pwm[idx].period;
-	} else if (value < 0) {
-		value = 0;
+int analogWriteFrequency(pin_size_t pinNumber, uint32_t frequency) {
+	size_t idx = pwm_pin_index(pinNumber);
+	uint64_t cycles_per_sec;
+	uint32_t period;
+	int err;
+
+	if (idx >= ARRAY_SIZE(arduino_pwm) || frequency == 0) {
+		return -EINVAL;
+	}
+
+	err = pwm_channel_setup(idx);
+	if (err < 0) {
+		return err;
+	}
+
+	err = pwm_get_cycles_per_sec(arduino_pwm[idx].dev, arduino_pwm[idx].channel, &cycles_per_sec);
+	if (err < 0) {
+		return err;
+	}
+
+	period = (uint32_t)(cycles_per_sec / frequency);
+	if (period == 0) {
+		return -ERANGE;
 	}
 
 	/*
-	 * A duty ratio determines by the period value defined in dts
-	 * and the value arguments. So usually the period value sets as 255.
+	 * Channels of the same pwm device share a counter, so the new
+	 * period applies to all of them. Running channels are written again
+	 * with their pulse scaled to keep the same duty cycle.
 	 */
-	(void)pwm_set_pulse_dt(&arduino_pwm[idx], value);
+	for (size_t i = 0; i < ARRAY_SIZE(arduino_pwm); i++) {
+		uint32_t old;
+		int ret;
+
+		if (arduino_pwm[i].dev != arduino_pwm[idx].dev || pwm_channel_setup(i) < 0) {
+			continue;
+		}
+
+		old = pwm_period_cycles[i];
+		pwm_period_cycles[i] = period;
+
+		if (pwm_active[i]) {
+			ret = pwm_channel_write(i, (uint32_t)((uint64_t)pwm_pulse[i] * period / old));
+			if (ret < 0 && err == 0) {
+				err = ret;
+			}
+		}
+	}
+
+	return err;
+}
+
+int analogWriteMany(const pin_size_t *pins, const int *values, size_t count) {
+	int err = 0;
+
+	/* Resolve all channels first, so that the updates below go out back-to-back */
+	for (size_t i = 0; i < count; i++) {
+		size_t idx = pwm_pin_index(pins[i]);
+
+		if (idx >= ARRAY_SIZE(arduino_pwm)) {
+			return -EINVAL;
+		}
+
+		err = pwm_channel_setup(idx);
+		if (err < 0) {
+			return err;
+		}
+	}
+
+	k_sched_lock();
+	for (size_t i = 0; i < count; i++) {
+		size_t idx = pwm_pin_index(pins[i]);
+
+		err = pwm_channel_write(idx, pwm_pulse_cycles(idx, values[i]));
+		if (err < 0) {
+			break;
+		}
+	}
+	k_sched_unlock();
+
+	return err;
 }
 
 #endif
 
 #ifdef CONFIG_DAC
+int dacChannelSetup(enum dacPins dacName, const struct device **dev,
+					const struct dac_channel_cfg **cfg) {
+	int err;
+
+	if (dacName >= NUM_OF_DACS) {
+		return -EINVAL;
+	}
+
+	if (!dac_ch_ready[dacName]) {
+		err = dac_channel_setup(dac_dev, &dac_ch_cfg[dacName]);
+		if (err < 0) {
+			return err;
+		}
+		dac_ch_ready[dacName] = true;
+	}
+
+	if (dev) {
+		*dev = dac_dev;
+	}
+	if (cfg) {
+		*cfg = &dac_ch_cfg[dacName];
+	}
+
+	return 0;
+}
+
 void analogWrite(enum dacPins dacName, int value) {
 	if (dacName >= NUM_OF_DACS) {
 		return;
 	}
 
-	dac_channel_setup(dac_dev, &dac_ch_cfg[dacName]);
+	if (dacChannelSetup(dacName, nullptr, nullptr) < 0) {
+		return;
+	}
 
 	const int max_dac_value = 1U << dac_ch_cfg[dacName].resolution;
 	dac_write_value(dac_dev, dac_ch_cfg[dacName].channel_id,
@@ -400,7 +840,7 @@ int analogRead(pin_size_t pinNumber) {
 
 	seq.channels = BIT(arduino_adc[idx].channel_id);
 	seq.resolution = arduino_adc[idx].resolution;
-	seq.oversampling = arduino_adc[idx].oversampling;
+	seq.oversampling = adc_oversampling[idx];
 
 	err = adc_read(arduino_adc[idx].dev, &seq);
 	if (err < 0) {
@@ -420,34 +860,89 @@ int analogRead(pin_size_t pinNumber) {
 	return buf << (read_resolution - seq.resolution);
 }
 
+int analogReadOversampling(pin_size_t pinNumber, uint16_t ratio) {
+	size_t idx = analog_pin_index(pinNumber);
+
+	if (idx >= ARRAY_SIZE(arduino_adc) || ratio == 0) {
+		return -EINVAL;
+	}
+
+	/*
+	 * The ADC averages 2^oversampling samples, so ratios that
+	 * are not a power of two are rounded down.
+	 */
+	adc_oversampling[idx] = 31 - __builtin_clz(ratio);
+	return 0;
+}
+
+int analogCalibrate() {
+	int err;
+	uint16_t buf;
+	struct adc_sequence seq = {.buffer = &buf, .buffer_size = sizeof(buf), .calibrate = true};
+
+	for (size_t i = 0; i < ARRAY_SIZE(arduino_adc); i++) {
+		bool calibrated = false;
+
+		/* Calibration applies to the whole converter, run it once per device */
+		for (size_t j = 0; j < i; j++) {
+			if (arduino_adc[j].dev == arduino_adc[i].dev) {
+				calibrated = true;
+				break;
+			}
+		}
+		if (calibrated) {
+			continue;
+		}
+
+		err = adc_channel_setup(arduino_adc[i].dev, &arduino_adc[i].channel_cfg);
+		if (err < 0) {
+			return err;
+		}
+
+		seq.channels = BIT(arduino_adc[i].channel_id);
+		seq.resolution = arduino_adc[i].resolution;
+		seq.oversampling = adc_oversampling[i];
+
+		err = adc_read(arduino_adc[i].dev, &seq);
+		if (err < 0) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+uint8_t analogPinOversampling(pin_size_t pinNumber) {
+	size_t idx = analog_pin_index(pinNumber);
+
+	return (idx < ARRAY_SIZE(arduino_adc)) ? adc_oversampling[idx] : 0;
+}
+
+const struct adc_dt_spec *analogPinToAdcSpec(pin_size_t pinNumber) {
+	size_t idx = analog_pin_index(pinNumber);
+
+	if (idx >= ARRAY_SIZE(arduino_adc)) {
+		return nullptr;
+	}
+
+	return &arduino_adc[idx];
+}
+
 #endif
 
 void attachInterrupt(pin_size_t pinNumber, voidFuncPtr callback, PinStatus pinStatus) {
 	struct gpio_port_callback *pcb;
-	gpio_flags_t intmode = 0;
-
-	if (!callback) {
-		return;
-	}
+	gpio_flags_t intmode = pin_status_to_intmode(pinStatus);
 
-	if (pinStatus == LOW) {
-		intmode |= GPIO_INT_LEVEL_LOW;
-	} else if (pinStatus == HIGH) {
-		intmode |= GPIO_INT_LEVEL_HIGH;
-	} else if (pinStatus == CHANGE) {
-		intmode |= GPIO_INT_EDGE_BOTH;
-	} else if (pinStatus == FALLING) {
-		intmode |= GPIO_INT_EDGE_FALLING;
-	} else if (pinStatus == RISING) {
-		intmode |= GPIO_INT_EDGE_RISING;
-	} else {
+	if (!callback || !intmode) {
 		return;
 	}
 
-	pcb = find_gpio_port_callback(arduino_pins[pinNumber].port);
+	pcb = find_gpio_port_callback(pinNumber);
 	__ASSERT(pcb != nullptr, "gpio_port_callback not found");
 
 	pcb->pins |= BIT(arduino_pins[pinNumber].pin);
+	pcb->handlers[arduino_pins[pinNumber].pin].mode = pinStatus;
 	setInterruptHandler(pinNumber, callback);
 	enableInterrupt(pinNumber);
 
@@ -460,25 +955,156 @@ void attachInterrupt(pin_size_t pinNumber, voidFuncPtr callback, PinStatus pinSt
 void detachInterrupt(pin_size_t pinNumber) {
 	setInterruptHandler(pinNumber, nullptr);
 	disableInterrupt(pinNumber);
+	gpio_irq_filter_release(pin_callback(pinNumber));
+}
+
+/*
+ * random() is backed by xoshiro128++, which is much faster than libc
+ * rand() and does not depend on it. Unless the sketch calls randomSeed(),
+ * the state is seeded from the system entropy source on first use. The
+ * state is shared by all threads and interrupts, updates hold prng_lock.
+ */
+
+static uint32_t prng_state[4];
+static bool prng_seeded = false;
+static struct k_spinlock prng_lock;
+
+static inline uint32_t prng_rotl(const uint32_t x, int k) {
+	return (x << k) | (x >> (32 - k));
+}
+
+static uint32_t prng_next(void) {
+	const uint32_t result = prng_rotl(prng_state[0] + prng_state[3], 7) + prng_state[0];
+	const uint32_t t = prng_state[1] << 9;
+
+	prng_state[2] ^= prng_state[0];
+	prng_state[3] ^= prng_state[1];
+	prng_state[1] ^= prng_state[2];
+	prng_state[0] ^= prng_state[3];
+	prng_state[2] ^= t;
+	prng_state[3] = prng_rotl(prng_state[3], 11);
+
+	return result;
+}
+
+/* Expand a 32 bit seed into the full state, as recommended by the xoshiro authors */
+static void prng_seed(uint32_t seed) {
+	for (size_t i = 0; i < ARRAY_SIZE(prng_state); i++) {
+		uint32_t z = (seed += 0x9e3779b9);
+
+		z = (z ^ (z >> 16)) * 0x85ebca6b;
+		z = (z ^ (z >> 13)) * 0xc2b2ae35;
+		prng_state[i] = z ^ (z >> 16);
+	}
+	prng_seeded = true;
+}
+
+static uint32_t prng_get(void) {
+	k_spinlock_key_t key;
+	uint32_t result;
+
+	// The entropy source may block, read it before taking the lock
+	if (!prng_seeded) {
+		uint32_t seed = 0;
+
+#if defined(CONFIG_CSPRNG_ENABLED)
+		if (sys_csrand_get(&seed, sizeof(seed)) < 0) {
+			seed = k_cycle_get_32();
+		}
+#elif defined(CONFIG_ENTROPY_GENERATOR) || defined(CONFIG_TEST_RANDOM_GENERATOR)
+		sys_rand_get(&seed, sizeof(seed));
+#else
+		seed = k_cycle_get_32();
+#endif
+		key = k_spin_lock(&prng_lock);
+		if (!prng_seeded) {
+			prng_seed(seed);
+		}
+		k_spin_unlock(&prng_lock, key);
+	}
+
+	key = k_spin_lock(&prng_lock);
+	result = prng_next();
+	k_spin_unlock(&prng_lock, key);
+
+	return result;
+}
+
+/* Unbiased value in [0, range) using Lemire's multiply-and-reject method */
+static uint32_t prng_range(uint32_t range) {
+	uint64_t m = (uint64_t)prng_get() * range;
+	uint32_t l = (uint32_t)m;
+
+	if (l < range) {
+		uint32_t threshold = -range % range;
+
+		while (l < threshold) {
+			m = (uint64_t)prng_get() * range;
+			l = (uint32_t)m;
+		}
+	}
+
+	return m >> 32;
 }
 
-#ifndef CONFIG_MINIMAL_LIBC_RAND
+/* Value in [0, range), wider ranges than 32 bits are masked and rejected */
+static uint64_t prng_range64(uint64_t range) {
+	uint64_t mask;
+	uint64_t r;
+
+	if (range <= UINT32_MAX) {
+		return prng_range((uint32_t)range);
+	}
+
+	mask = UINT64_MAX >> __builtin_clzll(range - 1);
+	do {
+		r = ((uint64_t)prng_get() << 32) | prng_get();
+		r &= mask;
+	} while (r >= range);
 
-#include <stdlib.h>
+	return r;
+}
 
 void randomSeed(unsigned long seed) {
-	srand(seed);
+	k_spinlock_key_t key = k_spin_lock(&prng_lock);
+
+	prng_seed(seed);
+	k_spin_unlock(&prng_lock, key);
 }
 
 long random(long min, long max) {
-	return rand() % (max - min) + min;
+	if (min >= max) {
+		return min;
+	}
+
+	// max - min may not fit in a long, nor in 32 bits where long is 64 bits wide
+	return (long)((uint64_t)min + prng_range64((uint64_t)max - (uint64_t)min));
 }
 
 long random(long max) {
-	return rand() % max;
+	if (max <= 0) {
+		return 0;
+	}
+
+	return (long)prng_range64(max);
 }
 
-#endif
+void randomBytes(void *buf, size_t len) {
+	uint8_t *dst = (uint8_t *)buf;
+	uint32_t r;
+
+	while (len >= sizeof(r)) {
+		r = prng_get();
+		memcpy(dst, &r, sizeof(r));
+		dst += sizeof(r);
+		len -= sizeof(r);
+	}
+
+	if (len) {
+		r = prng_get();
+		memcpy(dst, &r, len);
+	}
+}
 
 #ifdef CONFIG_GPIO_GET_DIRECTION
 
@@ -528,7 +1154,7 @@ cleanup:
 #endif // CONFIG_GPIO_GET_DIRECTION
 
 void enableInterrupt(pin_size_t pinNumber) {
-	struct gpio_port_callback *pcb = find_gpio_port_callback(arduino_pins[pinNumber].port);
+	struct gpio_port_callback *pcb = find_gpio_port_callback(pinNumber);
 
 	if (pcb) {
 		pcb->handlers[arduino_pins[pinNumber].pin].enabled = true;
@@ -536,7 +1162,7 @@ void enableInterrupt(pin_size_t pinNumber) {
 }
 
 void disableInterrupt(pin_size_t pinNumber) {
-	struct gpio_port_callback *pcb = find_gpio_port_callback(arduino_pins[pinNumber].port);
+	struct gpio_port_callback *pcb = find_gpio_port_callback(pinNumber);
 
 	if (pcb) {
 		pcb->handlers[arduino_pins[pinNumber].pin].enabled = false;
@@ -557,8 +1183,172 @@ void noInterrupts(void) {
 	}
 }
 
+int setInterruptDebounce(pin_size_t pinNumber, unsigned long us) {
+	struct gpio_irq_filter *filter;
+
+	if (!pin_callback(pinNumber)) {
+		return -EINVAL;
+	}
+
+	filter = gpio_irq_filter_get(pinNumber);
+	if (!filter) {
+		return -ENOMEM;
+	}
+
+	filter->debounce_us = us;
+	gpio_irq_filter_put(pinNumber, filter);
+	return 0;
+}
+
+int setInterruptRateLimit(pin_size_t pinNumber, unsigned int maxPerSecond) {
+	struct gpio_irq_filter *filter;
+
+	if (!pin_callback(pinNumber)) {
+		return -EINVAL;
+	}
+
+	filter = gpio_irq_filter_get(pinNumber);
+	if (!filter) {
+		return -ENOMEM;
+	}
+
+	filter->max_rate = maxPerSecond;
+	gpio_irq_filter_put(pinNumber, filter);
+	return 0;
+}
+
+unsigned long getInterruptThrottleCount(pin_size_t pinNumber) {
+	struct arduino_callback *cb = pin_callback(pinNumber);
+
+	if (!cb || !cb->filter) {
+		return 0;
+	}
+
+	return gpio_irq_filters[cb->filter - 1].throttle_count;
+}
+
 int digitalPinToInterrupt(pin_size_t pin) {
-	struct gpio_port_callback *pcb = find_gpio_port_callback(arduino_pins[pin].port);
+	struct gpio_port_callback *pcb = find_gpio_port_callback(pin);
 
 	return (pcb) ? pin : -1;
 }
+
+const struct gpio_dt_spec *digitalPinToGpioSpec(pin_size_t pin) {
+	return (pin < ARRAY_SIZE(arduino_pins)) ? &arduino_pins[pin] : nullptr;
+}
+
+#ifdef CONFIG_COUNTER
+
+const struct device *counterAcquire(void) {
+#if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), counters)
+	for (size_t i = 0; i < ARRAY_SIZE(arduino_counters); i++) {
+		if (atomic_test_and_set_bit(&arduino_counters_used, i)) {
+			continue;
+		}
+
+		if (device_is_ready(arduino_counters[i])) {
+			return arduino_counters[i];
+		}
+
+		atomic_clear_bit(&arduino_counters_used, i);
+	}
+#endif
+
+	return nullptr;
+}
+
+void counterRelease(const struct device *dev) {
+#if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), counters)
+	for (size_t i = 0; i < ARRAY_SIZE(arduino_counters); i++) {
+		if (arduino_counters[i] == dev) {
+			atomic_clear_bit(&arduino_counters_used, i);
+			return;
+		}
+	}
+#else
+	ARG_UNUSED(dev);
+#endif
+}
+
+#endif // CONFIG_COUNTER
+
+#ifdef CONFIG_EVENTS
+
+namespace {
+
+struct k_event loop_event;
+volatile bool loop_event_driven;
+unsigned long loop_max_sleep_ms;
+uint32_t loop_wake_events;
+
+} // anonymous namespace
+
+int loopOnEvents(unsigned long maxSleepMs) {
+	if (!loop_event_driven) {
+		k_event_init(&loop_event);
+	}
+
+	loop_max_sleep_ms = maxSleepMs;
+	loop_event_driven = true;
+
+	return 0;
+}
+
+void loopContinuously(void) {
+	/* Release a loopWait() blocked without timeout, wake() is a no-op afterwards */
+	if (loop_event_driven) {
+		k_event_post(&loop_event, LOOP_EVENT_USER);
+	}
+
+	loop_event_driven = false;
+	loop_wake_events = 0;
+}
+
+void wake(uint32_t events) {
+	if (loop_event_driven) {
+		k_event_post(&loop_event, events);
+	}
+}
+
+uint32_t loopWakeEvents(void) {
+	return loop_wake_events;
+}
+
+void loopWait(void) {
+	k_timeout_t timeout = loop_max_sleep_ms ? K_MSEC(loop_max_sleep_ms) : K_FOREVER;
+
+	if (!loop_event_driven) {
+		return;
+	}
+
+	/*
+	 * Only clear what was seen, so that an event posted while loop() runs
+	 * makes the next wait return immediately.
+	 */
+	loop_wake_events = k_event_wait(&loop_event, LOOP_EVENT_ALL, false, timeout);
+	k_event_clear(&loop_event, loop_wake_events);
+}
+
+#else
+
+int loopOnEvents(unsigned long maxSleepMs) {
+	ARG_UNUSED(maxSleepMs);
+
+	return -ENOTSUP;
+}
+
+void loopContinuously(void) {
+}
+
+void wake(uint32_t events) {
+	ARG_UNUSED(events);
+}
+
+uint32_t loopWakeEvents(void) {
+	return 0;
+}
+
+void loopWait(void) {
+}
+
+#endif // CONFIG_EVENTS
@@ -14,6 +14,29 @@ extern "C" {
 
 void enableInterrupt(pin_size_t);
 void disableInterrupt(pin_size_t);
+/* Returns the GPIO behind an Arduino pin, or NULL if there is no such pin */
+const struct gpio_dt_spec *digitalPinToGpioSpec(pin_size_t);
+
+/* Called by main() between loop() iterations, sleeps when loopOnEvents() is active */
+void loopWait(void);
+
+#ifdef CONFIG_ADC
+/* Returns the ADC channel bound to an Arduino pin, or NULL if it is not an analog pin */
+const struct adc_dt_spec *analogPinToAdcSpec(pin_size_t);
+/* Returns the oversampling set by analogReadOversampling(), as log2 of the ratio */
+uint8_t analogPinOversampling(pin_size_t);
+#endif
+
+#ifdef CONFIG_DAC
+/* Configures a DAC channel on first use and optionally returns its device and configuration */
+int dacChannelSetup(enum dacPins, const struct device **, const struct dac_channel_cfg **);
+#endif
+
+#ifdef CONFIG_COUNTER
+/* Claims a free counter listed in the zephyr,user counters property, or returns NULL */
+const struct device *counterAcquire(void);
+void counterRelease(const struct device *);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
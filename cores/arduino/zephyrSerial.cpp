@@ -72,6 +72,7 @@ void arduino::ZephyrSerial::IrqHandler() {
 	uint8_t buf[8];
 	int length;
 	int ret = 0;
+	bool received = false;
 
 	if (!uart_irq_update(uart)) {
 		return;
@@ -81,6 +82,7 @@ void arduino::ZephyrSerial::IrqHandler() {
 	while (uart_irq_rx_ready(uart) && ((length = uart_fifo_read(uart, buf, sizeof(buf))) > 0)) {
 		length = min(sizeof(buf), static_cast<size_t>(length));
 		ret = ring_buf_put(&rx.ringbuf, &buf[0], length);
+		received = true;
 
 		if (ret < 0) {
 			break;
@@ -88,6 +90,10 @@ void arduino::ZephyrSerial::IrqHandler() {
 	}
 	k_sem_give(&rx.sem);
 
+	if (received) {
+		wake(LOOP_EVENT_SERIAL);
+	}
+
 	k_sem_take(&tx.sem, K_NO_WAIT);
 
 	if (ring_buf_size_get(&tx.ringbuf) == 0) {
@@ -8,12 +8,39 @@
 #include "zephyrInternal.h"
 #include <zephyr/kernel.h>
 
+namespace {
+
+void swap_words(void *buf, size_t count, size_t width) {
+	if (width == sizeof(uint16_t)) {
+		uint16_t *words = static_cast<uint16_t *>(buf);
+
+		for (size_t i = 0; i < count; i++) {
+			words[i] = __builtin_bswap16(words[i]);
+		}
+	} else {
+		uint32_t *words = static_cast<uint32_t *>(buf);
+
+		for (size_t i = 0; i < count; i++) {
+			words[i] = __builtin_bswap32(words[i]);
+		}
+	}
+}
+
+} // anonymous namespace
+
 arduino::ZephyrSPI::ZephyrSPI(const struct device *spi) : spi_dev(spi) {
+	config = &configCache[0].config;
+	config16 = &configCache[0].config16;
+	config32 = &configCache[0].config32;
+	k_mutex_init(&busLock);
+#ifdef CONFIG_SPI_ASYNC
+	k_sem_init(&asyncIdle, 1, 1);
+#endif
 }
 
 uint8_t arduino::ZephyrSPI::transfer(uint8_t data) {
 	uint8_t rx = data;
-	if (transfer(&rx, sizeof(rx), &config) < 0) {
+	if (transfer(&rx, sizeof(rx), config) < 0) {
 		return 0;
 	}
 	return rx;
@@ -21,20 +48,55 @@ uint8_t arduino::ZephyrSPI::transfer(uint8_t data) {
 
 uint16_t arduino::ZephyrSPI::transfer16(uint16_t data) {
 	uint16_t rx = data;
-	if (transfer(&rx, sizeof(rx), &config16) < 0) {
+	if (transfer(&rx, sizeof(rx), config16) < 0) {
 		return 0;
 	}
 	return rx;
 }
 
 void arduino::ZephyrSPI::transfer(void *buf, size_t count) {
-	int ret = transfer(buf, count, &config);
+	int ret = transfer(buf, count, config);
 	(void)ret;
 }
 
-int arduino::ZephyrSPI::transfer(void *buf, size_t len, const struct spi_config *config) {
+int arduino::ZephyrSPI::transfer16(uint16_t *buf, size_t count, bool swapBytes) {
+	return transferWords(buf, count, sizeof(uint16_t), swapBytes);
+}
+
+int arduino::ZephyrSPI::transfer32(uint32_t *buf, size_t count, bool swapBytes) {
+	return transferWords(buf, count, sizeof(uint32_t), swapBytes);
+}
+
+int arduino::ZephyrSPI::transferWords(void *buf, size_t count, size_t width, bool swapBytes) {
+	const struct spi_config *wide = (width == sizeof(uint16_t)) ? config16 : config32;
+	bool msb_first = !(config->operation & SPI_TRANSFER_LSB);
 	int ret;
 
+	if (swapBytes) {
+		swap_words(buf, count, width);
+	}
+
+	ret = transfer(buf, count * width, wide);
+
+	/* No wide frames on this controller: send bytes in the order the words would go out */
+	if (ret == -ENOTSUP) {
+		if (msb_first) {
+			swap_words(buf, count, width);
+		}
+		ret = transfer(buf, count * width, config);
+		if (msb_first) {
+			swap_words(buf, count, width);
+		}
+	}
+
+	if (swapBytes) {
+		swap_words(buf, count, width);
+	}
+
+	return ret;
+}
+
+int arduino::ZephyrSPI::transfer(void *buf, size_t len, const struct spi_config *config) {
 	const struct spi_buf tx_buf = {.buf = buf, .len = len};
 	const struct spi_buf_set tx_buf_set = {
 		.buffers = &tx_buf,
@@ -47,16 +109,415 @@ int arduino::ZephyrSPI::transfer(void *buf, size_t len, const struct spi_config
 		.count = 1,
 	};
 
-	return spi_transceive(spi_dev, config, &tx_buf_set, &rx_buf_set);
+	return transceive(&tx_buf_set, &rx_buf_set, config);
+}
+
+int arduino::ZephyrSPI::transfer(const void *tx, void *rx, size_t len) {
+	const struct spi_buf tx_buf = {.buf = const_cast<void *>(tx), .len = len};
+	const struct spi_buf_set tx_buf_set = {
+		.buffers = &tx_buf,
+		.count = 1,
+	};
+
+	const struct spi_buf rx_buf = {.buf = rx, .len = len};
+	const struct spi_buf_set rx_buf_set = {
+		.buffers = &rx_buf,
+		.count = 1,
+	};
+
+	return transceive(tx ? &tx_buf_set : NULL, rx ? &rx_buf_set : NULL, config);
+}
+
+int arduino::ZephyrSPI::transfer(const SPISegment *segments, size_t count) {
+	struct spi_buf tx_bufs[SPI_MAX_SEGMENTS];
+	struct spi_buf rx_bufs[SPI_MAX_SEGMENTS];
+	bool has_tx = false;
+	bool has_rx = false;
+
+	if (count == 0 || count > SPI_MAX_SEGMENTS) {
+		return -EINVAL;
+	}
+
+	/* A NULL buffer in a spi_buf sends dummy bytes or drops the received ones */
+	for (size_t i = 0; i < count; i++) {
+		tx_bufs[i] = {.buf = const_cast<void *>(segments[i].tx), .len = segments[i].len};
+		rx_bufs[i] = {.buf = segments[i].rx, .len = segments[i].len};
+		has_tx |= (segments[i].tx != NULL);
+		has_rx |= (segments[i].rx != NULL);
+	}
+
+	const struct spi_buf_set tx_buf_set = {
+		.buffers = tx_bufs,
+		.count = count,
+	};
+
+	const struct spi_buf_set rx_buf_set = {
+		.buffers = rx_bufs,
+		.count = count,
+	};
+
+	return transceive(has_tx ? &tx_buf_set : NULL, has_rx ? &rx_buf_set : NULL, config);
+}
+
+int arduino::ZephyrSPI::transfer(const struct spi_buf_set *tx, const struct spi_buf_set *rx) {
+	return transceive(tx, rx, config);
 }
 
+int arduino::ZephyrSPI::transceive(const struct spi_buf_set *tx, const struct spi_buf_set *rx,
+								   const struct spi_config *config) {
+	int ret;
+
+	/* Recursive, so this only blocks transfers outside of a transaction */
+	k_mutex_lock(&busLock, K_FOREVER);
+	configDriver = config;
+	ret = spi_transceive(spi_dev, config, tx, rx);
+	k_mutex_unlock(&busLock);
+
+	return ret;
+}
+
+#ifdef CONFIG_SPI_ASYNC
+arduino::SPIAsyncTransfer::SPIAsyncTransfer() {
+	k_sem_init(&complete, 0, 1);
+}
+
+bool arduino::SPIAsyncTransfer::poll() {
+	return !atomic_get(&busy);
+}
+
+int arduino::SPIAsyncTransfer::wait() {
+	if (!poll()) {
+		k_sem_take(&complete, K_FOREVER);
+	}
+
+	return _result;
+}
+
+void arduino::SPIAsyncTransfer::done(const struct device *dev, int result, void *data) {
+	SPIAsyncTransfer *xfer = static_cast<SPIAsyncTransfer *>(data);
+
+	ARG_UNUSED(dev);
+
+	xfer->_result = result;
+	if (xfer->pin) {
+		atomic_dec(xfer->pin);
+		xfer->pin = nullptr;
+	}
+	/* Let endTransaction() release the bus */
+	k_sem_give(xfer->busIdle);
+
+	if (xfer->cb) {
+		xfer->cb(result, xfer->arg);
+	}
+
+	atomic_clear(&xfer->busy);
+	k_sem_give(&xfer->complete);
+}
+
+int arduino::ZephyrSPI::transferAsync(const void *tx, void *rx, size_t len,
+									  SPIAsyncTransfer &xfer, SPIAsyncCallback cb, void *arg) {
+	int ret;
+
+	if (!atomic_cas(&xfer.busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	xfer.tx_buf = {.buf = const_cast<void *>(tx), .len = len};
+	xfer.tx_set = {.buffers = &xfer.tx_buf, .count = 1};
+	xfer.rx_buf = {.buf = rx, .len = len};
+	xfer.rx_set = {.buffers = &xfer.rx_buf, .count = 1};
+	xfer.cb = cb;
+	xfer.arg = arg;
+	xfer.busIdle = &asyncIdle;
+	k_sem_reset(&xfer.complete);
+
+	k_mutex_lock(&busLock, K_FOREVER);
+
+	/* The driver reads the configuration while the transfer runs, keep it as is until done */
+	xfer.pin = nullptr;
+	for (auto &e : configCache) {
+		if (configOwns(e, config)) {
+			xfer.pin = &e.pins;
+			atomic_inc(xfer.pin);
+			break;
+		}
+	}
+
+	/* One asynchronous transfer at a time, the driver keeps the bus until it is done */
+	k_sem_take(&asyncIdle, K_FOREVER);
+	configDriver = config;
+	ret = spi_transceive_cb(spi_dev, config, tx ? &xfer.tx_set : NULL, rx ? &xfer.rx_set : NULL,
+							SPIAsyncTransfer::done, &xfer);
+	k_mutex_unlock(&busLock);
+
+	if (ret < 0) {
+		k_sem_give(&asyncIdle);
+		if (xfer.pin) {
+			atomic_dec(xfer.pin);
+			xfer.pin = nullptr;
+		}
+		xfer._result = ret;
+		atomic_clear(&xfer.busy);
+	}
+
+	return ret;
+}
+#endif
+
+#ifdef CONFIG_SPI_ASYNC
+arduino::SPIPeripheralStream::SPIPeripheralStream(ZephyrSPI &spi) : _spi(spi) {
+	k_work_init(&_deliver.work, deliver);
+	_deliver.stream = this;
+	k_sem_init(&_idle, 0, 1);
+}
+
+int arduino::SPIPeripheralStream::begin(SPISettings settings, uint8_t *buffer, size_t count,
+										SPIStreamCallback cb) {
+	int ret;
+
+	if (_started) {
+		return -EBUSY;
+	}
+
+	if (!buffer || !cb || count == 0) {
+		return -EINVAL;
+	}
+
+	_config = {};
+	_config.operation = ZephyrSPI::settingsToOperation(settings) | SPI_OP_MODE_SLAVE |
+						SPI_LOCK_ON | SPI_WORD_SET(8);
+	_config.frequency = settings.getClockFreq();
+
+	_buffer = buffer;
+	_count = count;
+	_cb = cb;
+	_overruns = 0;
+	atomic_clear(&_pending);
+	k_sem_reset(&_idle);
+
+	_running = true;
+	ret = arm(0);
+	if (ret < 0) {
+		_running = false;
+		spi_release(_spi.spi_dev, &_config);
+		return ret;
+	}
+
+	_started = true;
+	return 0;
+}
+
+void arduino::SPIPeripheralStream::end() {
+	struct k_work_sync sync;
+	unsigned int key;
+	bool armed;
+
+	if (!_started) {
+		return;
+	}
+
+	/* Taken with interrupts off so that done() either re-armed already or sees the stop */
+	key = irq_lock();
+	_running = false;
+	armed = _armed;
+	irq_unlock(key);
+
+	/*
+	 * Zephyr cannot abort a peripheral transfer, and the driver writes into
+	 * the buffer until it completes. Only release the bus after that.
+	 */
+	if (armed) {
+		k_sem_take(&_idle, K_FOREVER);
+	}
+
+	k_work_cancel_sync(&_deliver.work, &sync);
+	spi_release(_spi.spi_dev, &_config);
+	_started = false;
+}
+
+int arduino::SPIPeripheralStream::arm(size_t half) {
+	int ret;
+
+	_half = half;
+	_rx_buf = {.buf = &_buffer[half * _count], .len = _count};
+	_rx_set = {.buffers = &_rx_buf, .count = 1};
+
+	_armed = true;
+	ret = spi_transceive_cb(_spi.spi_dev, &_config, NULL, &_rx_set, done, this);
+	if (ret < 0) {
+		_armed = false;
+	}
+
+	return ret;
+}
+
+void arduino::SPIPeripheralStream::done(const struct device *dev, int result, void *data) {
+	SPIPeripheralStream *stream = static_cast<SPIPeripheralStream *>(data);
+	size_t half = stream->_half;
+
+	ARG_UNUSED(dev);
+
+	stream->_armed = false;
+
+	if (!stream->_running) {
+		k_sem_give(&stream->_idle);
+		return;
+	}
+
+	/* In peripheral mode the result is the number of frames received */
+	if (result <= 0 || atomic_test_bit(&stream->_pending, !half)) {
+		stream->_overruns++;
+		if (stream->arm(half) < 0) {
+			stream->_running = false;
+		}
+		return;
+	}
+
+	stream->_len[half] = result;
+	if (stream->arm(!half) < 0) {
+		stream->_running = false;
+	}
+
+	atomic_set_bit(&stream->_pending, half);
+	k_work_submit(&stream->_deliver.work);
+}
+
+void arduino::SPIPeripheralStream::deliver(struct k_work *work) {
+	struct deliver_work *deliver = CONTAINER_OF(work, struct deliver_work, work);
+	SPIPeripheralStream *stream = deliver->stream;
+
+	for (size_t half = 0; half < 2; half++) {
+		if (atomic_test_bit(&stream->_pending, half)) {
+			stream->_cb(&stream->_buffer[half * stream->_count], stream->_len[half]);
+			atomic_clear_bit(&stream->_pending, half);
+		}
+	}
+}
+#endif
+
+#ifdef CONFIG_MULTITHREADING
+namespace {
+
+K_KERNEL_STACK_DEFINE(spi_queue_stack, CONFIG_ARDUINO_SPI_QUEUE_STACK_SIZE);
+struct k_thread spi_queue_thread;
+struct k_fifo spi_queue;
+bool spi_queue_started;
+
+} // anonymous namespace
+
+arduino::SPIRequest::SPIRequest() {
+	k_sem_init(&complete, 0, 1);
+}
+
+void arduino::SPIRequest::set(const SPISettings &settings, const void *tx, void *rx, size_t len,
+							  int csPin, SPIRequestCallback cb, void *arg) {
+	this->settings = settings;
+	this->tx = tx;
+	this->rx = rx;
+	this->len = len;
+	this->csPin = csPin;
+	this->cb = cb;
+	this->arg = arg;
+}
+
+bool arduino::SPIRequest::done() {
+	return !atomic_get(&busy);
+}
+
+int arduino::SPIRequest::wait() {
+	if (!done()) {
+		k_sem_take(&complete, K_FOREVER);
+	}
+
+	return _result;
+}
+
+int arduino::ZephyrSPI::enqueue(SPIRequest &req) {
+	if (!atomic_cas(&req.busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	req.bus = this;
+	k_sem_reset(&req.complete);
+
+	/* The worker thread is only created once a request is queued */
+	k_sched_lock();
+	if (!spi_queue_started) {
+		k_fifo_init(&spi_queue);
+		k_thread_create(&spi_queue_thread, spi_queue_stack,
+						K_KERNEL_STACK_SIZEOF(spi_queue_stack), queueEntry, NULL, NULL, NULL,
+						CONFIG_ARDUINO_SPI_QUEUE_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&spi_queue_thread, "spi_queue");
+		spi_queue_started = true;
+	}
+	k_sched_unlock();
+
+	k_fifo_put(&spi_queue, &req);
+
+	return 0;
+}
+
+void arduino::ZephyrSPI::runRequest(SPIRequest &req) {
+	const struct spi_config *req_config;
+
+	k_mutex_lock(&busLock, K_FOREVER);
+
+	req_config = &configLookup(req.settings)->config;
+
+	if (req.csPin >= 0) {
+		digitalWrite(req.csPin, LOW);
+	}
+
+	const struct spi_buf tx_buf = {.buf = const_cast<void *>(req.tx), .len = req.len};
+	const struct spi_buf_set tx_buf_set = {
+		.buffers = &tx_buf,
+		.count = 1,
+	};
+
+	const struct spi_buf rx_buf = {.buf = req.rx, .len = req.len};
+	const struct spi_buf_set rx_buf_set = {
+		.buffers = &rx_buf,
+		.count = 1,
+	};
+
+	req._result = transceive(req.tx ? &tx_buf_set : NULL, req.rx ? &rx_buf_set : NULL,
+							 req_config);
+	spi_release(spi_dev, req_config);
+
+	if (req.csPin >= 0) {
+		digitalWrite(req.csPin, HIGH);
+	}
+
+	k_mutex_unlock(&busLock);
+
+	if (req.cb) {
+		req.cb(req._result, req.arg);
+	}
+
+	atomic_clear(&req.busy);
+	k_sem_give(&req.complete);
+}
+
+void arduino::ZephyrSPI::queueEntry(void *p1, void *p2, void *p3) {
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		SPIRequest *req = static_cast<SPIRequest *>(k_fifo_get(&spi_queue, K_FOREVER));
+
+		req->bus->runRequest(*req);
+	}
+}
+#endif
+
 void arduino::ZephyrSPI::usingInterrupt(int interruptNumber) {
 }
 
 void arduino::ZephyrSPI::notUsingInterrupt(int interruptNumber) {
 }
 
-void arduino::ZephyrSPI::beginTransaction(SPISettings settings) {
+uint32_t arduino::ZephyrSPI::settingsToOperation(const SPISettings &settings) {
 	uint32_t mode = SPI_HOLD_ON_CS;
 
 	// Set bus mode
@@ -93,19 +554,95 @@ void arduino::ZephyrSPI::beginTransaction(SPISettings settings) {
 		break;
 	}
 
-	// Set SPI configuration structure for 8-bit transfers
-	memset(&config, 0, sizeof(struct spi_config));
-	config.operation = mode | SPI_WORD_SET(8);
-	config.frequency = max(SPI_MIN_CLOCK_FREQUENCY, settings.getClockFreq());
+	return mode;
+}
+
+struct arduino::ZephyrSPI::config_entry *
+arduino::ZephyrSPI::configLookup(const SPISettings &settings) {
+	struct config_entry *entry = NULL;
+	uint32_t mode;
+
+	for (auto &e : configCache) {
+		if (e.valid && e.settings == settings) {
+			entry = &e;
+			break;
+		}
+	}
+
+	/*
+	 * The driver skips reconfiguration when handed the same spi_config
+	 * pointer as last time, so the entry it was given last is never
+	 * rewritten. Neither are the entry the current transaction uses and
+	 * those of asynchronous transfers: at most one running and one waiting
+	 * for it in transferAsync() under busLock. That leaves at least one
+	 * free entry, see the static_assert in SPI.h.
+	 */
+	while (!entry) {
+		struct config_entry *e = &configCache[configNext];
+
+		configNext = (configNext + 1) % SPI_CONFIG_CACHE_SIZE;
+		if (configOwns(*e, configDriver) || configOwns(*e, config) || atomic_get(&e->pins)) {
+			continue;
+		}
+		entry = e;
 
-	// Set SPI configuration structure for 16-bit transfers
-	memset(&config16, 0, sizeof(struct spi_config));
-	config16.operation = mode | SPI_WORD_SET(16);
-	config16.frequency = max(SPI_MIN_CLOCK_FREQUENCY, settings.getClockFreq());
+		mode = settingsToOperation(settings);
+
+		// Set SPI configuration structure for 8-bit transfers
+		memset(&entry->config, 0, sizeof(struct spi_config));
+		entry->config.operation = mode | SPI_WORD_SET(8);
+		entry->config.frequency = max(SPI_MIN_CLOCK_FREQUENCY, settings.getClockFreq());
+		entry->config.cs = csControl;
+
+		// Set SPI configuration structure for 16-bit transfers
+		entry->config16 = entry->config;
+		entry->config16.operation = mode | SPI_WORD_SET(16);
+
+		// Set SPI configuration structure for 32-bit transfers
+		entry->config32 = entry->config;
+		entry->config32.operation = mode | SPI_WORD_SET(32);
+
+		entry->settings = settings;
+		entry->valid = true;
+	}
+
+	return entry;
+}
+
+bool arduino::ZephyrSPI::configOwns(const struct config_entry &entry,
+									const struct spi_config *config) {
+	return config == &entry.config || config == &entry.config16 || config == &entry.config32;
+}
+
+void arduino::ZephyrSPI::configInvalidate() {
+	for (auto &e : configCache) {
+		e.valid = false;
+	}
+}
+
+void arduino::ZephyrSPI::beginTransaction(SPISettings settings) {
+	struct config_entry *entry;
+
+	k_mutex_lock(&busLock, K_FOREVER);
+
+	entry = configLookup(settings);
+	config = &entry->config;
+	config16 = &entry->config16;
+	config32 = &entry->config32;
 }
 
 void arduino::ZephyrSPI::endTransaction(void) {
-	spi_release(spi_dev, &config);
+	/* spi_release() unlocks the driver and drops chip select, even mid-transfer */
+	waitAsyncIdle();
+	spi_release(spi_dev, config);
+	k_mutex_unlock(&busLock);
+}
+
+void arduino::ZephyrSPI::waitAsyncIdle() {
+#ifdef CONFIG_SPI_ASYNC
+	k_sem_take(&asyncIdle, K_FOREVER);
+	k_sem_give(&asyncIdle);
+#endif
 }
 
 void arduino::ZephyrSPI::attachInterrupt() {
@@ -118,6 +655,49 @@ void arduino::ZephyrSPI::begin() {
 }
 
 void arduino::ZephyrSPI::end() {
+	k_mutex_lock(&busLock, K_FOREVER);
+	waitAsyncIdle();
+	spi_release(spi_dev, config);
+	k_mutex_unlock(&busLock);
+}
+
+int arduino::ZephyrSPI::setChipSelect(pin_size_t pin, uint32_t delay) {
+	const struct gpio_dt_spec *spec = digitalPinToGpioSpec(pin);
+	struct gpio_dt_spec cs;
+
+	if (!spec) {
+		return -EINVAL;
+	}
+
+	cs = *spec;
+	cs.dt_flags |= GPIO_ACTIVE_LOW;
+
+	return setChipSelect(cs, delay);
+}
+
+int arduino::ZephyrSPI::setChipSelect(const struct gpio_dt_spec &cs, uint32_t delay) {
+	int ret;
+
+	/* The driver only toggles the pin, it expects it to be configured */
+	ret = gpio_pin_configure_dt(&cs, GPIO_OUTPUT_INACTIVE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	csControl.gpio = cs;
+	csControl.delay = delay;
+	configInvalidate();
+	k_mutex_unlock(&busLock);
+
+	return 0;
+}
+
+void arduino::ZephyrSPI::clearChipSelect() {
+	k_mutex_lock(&busLock, K_FOREVER);
+	csControl = {};
+	configInvalidate();
+	k_mutex_unlock(&busLock);
 }
 
 #if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), spis)
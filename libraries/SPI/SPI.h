@@ -36,8 +36,122 @@
 	DT_FOREACH_PROP_ELEM_SEP(DT_PATH(zephyr_user), digital_pin_gpios,            \
                            INTERRUPT_HELPER, (+))
 
+/* Number of distinct SPISettings per bus whose driver configuration is kept */
+#ifndef SPI_CONFIG_CACHE_SIZE
+#define SPI_CONFIG_CACHE_SIZE 5
+#endif
+
+/*
+ * Entries in use by the driver, the current transaction, and a running and a
+ * queued asynchronous transfer are never evicted, plus one to fill
+ */
+static_assert(SPI_CONFIG_CACHE_SIZE >= 5, "SPI_CONFIG_CACHE_SIZE must be at least 5");
+
+/* Segments handled by a single transfer(const SPISegment *, size_t) call */
+#ifndef SPI_MAX_SEGMENTS
+#define SPI_MAX_SEGMENTS 8
+#endif
+
 namespace arduino {
+
+/* One part of a multi-segment transfer, tx or rx may be NULL */
+struct SPISegment {
+	const void *tx;
+	void *rx;
+	size_t len;
+};
+
+#ifdef CONFIG_SPI_ASYNC
+typedef void (*SPIAsyncCallback)(int result, void *arg);
+
+/*
+ * State of one transferAsync(), owned by the caller. It must stay valid,
+ * together with the data buffers, until the transfer has completed.
+ */
+class SPIAsyncTransfer {
+public:
+	SPIAsyncTransfer();
+
+	/* True once the transfer is over, without blocking */
+	bool poll();
+	/* Blocks until the transfer is over and returns its result */
+	int wait();
+
+	int result() const {
+		return _result;
+	}
+
+private:
+	friend class ZephyrSPI;
+	static void done(const struct device *dev, int result, void *data);
+
+	struct spi_buf tx_buf;
+	struct spi_buf rx_buf;
+	struct spi_buf_set tx_set;
+	struct spi_buf_set rx_set;
+	SPIAsyncCallback cb = nullptr;
+	void *arg = nullptr;
+	atomic_t busy = ATOMIC_INIT(0);
+	int _result = 0;
+	struct k_sem complete;
+	/* Keeps the cached configuration of the transfer from being rewritten */
+	atomic_t *pin = nullptr;
+	struct k_sem *busIdle = nullptr;
+};
+#endif
+
+#ifdef CONFIG_MULTITHREADING
+class ZephyrSPI;
+
+typedef void (*SPIRequestCallback)(int result, void *arg);
+
+/*
+ * One transfer for SPI.enqueue(), owned by the caller. The request and its
+ * buffers must stay valid until done() returns true.
+ */
+class SPIRequest {
+public:
+	SPIRequest();
+
+	/* csPin is driven low around the transfer unless it is -1 */
+	void set(const SPISettings &settings, const void *tx, void *rx, size_t len, int csPin = -1,
+			 SPIRequestCallback cb = nullptr, void *arg = nullptr);
+
+	bool done();
+	/* Blocks until the request has run and returns its result */
+	int wait();
+
+	int result() const {
+		return _result;
+	}
+
+private:
+	friend class ZephyrSPI;
+
+	void *fifo_reserved;
+	ZephyrSPI *bus = nullptr;
+	SPISettings settings;
+	const void *tx = nullptr;
+	void *rx = nullptr;
+	size_t len = 0;
+	int csPin = -1;
+	SPIRequestCallback cb = nullptr;
+	void *arg = nullptr;
+	atomic_t busy = ATOMIC_INIT(0);
+	int _result = 0;
+	struct k_sem complete;
+};
+#endif
+
+#ifdef CONFIG_SPI_ASYNC
+class SPIPeripheralStream;
+#endif
+
 class ZephyrSPI : public HardwareSPI {
+#ifdef CONFIG_SPI_ASYNC
+	friend class SPIPeripheralStream;
+#endif
+
 public:
 	ZephyrSPI(const struct device *spi);
 
@@ -45,6 +159,41 @@ public:
 	virtual uint16_t transfer16(uint16_t data);
 	virtual void transfer(void *buf, size_t count);
 
+	/*
+	 * Whole buffers of 16 or 32 bit frames in one transfer. Words are sent
+	 * in the bit order of the transaction, e.g. most significant byte
+	 * first with MSBFIRST. Set swapBytes when the buffer holds words of
+	 * the other endianness; it is swapped back before returning.
+	 */
+	int transfer16(uint16_t *buf, size_t count, bool swapBytes = false);
+	int transfer32(uint32_t *buf, size_t count, bool swapBytes = false);
+
+	/* Separate buffers, either tx or rx may be NULL */
+	int transfer(const void *tx, void *rx, size_t len);
+	/* Segments go out back to back with chip select held, in one transceive */
+	int transfer(const SPISegment *segments, size_t count);
+	int transfer(const struct spi_buf_set *tx, const struct spi_buf_set *rx);
+
+#ifdef CONFIG_SPI_ASYNC
+	/*
+	 * Starts a transfer with the current transaction settings and returns
+	 * right away. Either tx or rx may be NULL. The callback, if any, runs
+	 * in interrupt context when the transfer is over. endTransaction() and
+	 * end() wait for it before releasing the bus.
+	 */
+	int transferAsync(const void *tx, void *rx, size_t len, SPIAsyncTransfer &xfer,
+					  SPIAsyncCallback cb = nullptr, void *arg = nullptr);
+#endif
+
+#ifdef CONFIG_MULTITHREADING
+	/*
+	 * Queues a request for the SPI worker thread, which runs requests from
+	 * all buses back to back. Settings are translated once and reused as
+	 * long as consecutive requests on a bus share them.
+	 */
+	int enqueue(SPIRequest &req);
+#endif
+
 	// Transaction Functions
 	virtual void usingInterrupt(int interruptNumber);
 	virtual void notUsingInterrupt(int interruptNumber);
@@ -58,17 +207,126 @@ public:
 	virtual void begin();
 	virtual void end();
 
+	/*
+	 * Let the driver drive chip select for every transaction, with `delay`
+	 * microseconds of setup and hold time. The pin form takes an Arduino
+	 * pin and treats it as active low; the gpio_dt_spec form takes its
+	 * flags from devicetree, e.g. a cs-gpios entry of the controller.
+	 */
+	int setChipSelect(pin_size_t pin, uint32_t delay = 0);
+	int setChipSelect(const struct gpio_dt_spec &cs, uint32_t delay = 0);
+	void clearChipSelect();
+
 private:
 	int transfer(void *buf, size_t len, const struct spi_config *config);
+	int transferWords(void *buf, size_t count, size_t width, bool swapBytes);
+	int transceive(const struct spi_buf_set *tx, const struct spi_buf_set *rx,
+				   const struct spi_config *config);
+	static uint32_t settingsToOperation(const SPISettings &settings);
+	void waitAsyncIdle();
+
+	struct config_entry {
+		SPISettings settings;
+		struct spi_config config;
+		struct spi_config config16;
+		struct spi_config config32;
+		bool valid;
+		/* Asynchronous transfers using the entry */
+		atomic_t pins;
+	};
+
+	struct config_entry *configLookup(const SPISettings &settings);
+	void configInvalidate();
+	static bool configOwns(const struct config_entry &entry, const struct spi_config *config);
+
+#ifdef CONFIG_MULTITHREADING
+	void runRequest(SPIRequest &req);
+	static void queueEntry(void *p1, void *p2, void *p3);
+#endif
+
+	struct config_entry configCache[SPI_CONFIG_CACHE_SIZE] = {};
+	/* Configuration handed to the driver last, see configLookup() */
+	const struct spi_config *configDriver = nullptr;
+	size_t configNext = 0;
+	struct spi_cs_control csControl = {};
+#ifdef CONFIG_SPI_ASYNC
+	/* Taken by transferAsync() until the transfer completes */
+	struct k_sem asyncIdle;
+#endif
 
 protected:
 	const struct device *spi_dev;
-	struct spi_config config;
-	struct spi_config config16;
+	const struct spi_config *config;
+	const struct spi_config *config16;
+	const struct spi_config *config32;
+	/* Held from beginTransaction() to endTransaction(), priority inheriting */
+	struct k_mutex busLock;
 	int interrupt[INTERRUPT_COUNT];
 	size_t interrupt_pos = 0;
 };
 
+#ifdef CONFIG_SPI_ASYNC
+typedef void (*SPIStreamCallback)(uint8_t *data, size_t len);
+
+/*
+ * Receives a continuous stream as an SPI peripheral (target).
+ *
+ * The user buffer is split in two halves. When the controller has filled
+ * one, the transfer into the other half is re-armed straight from the
+ * completion interrupt, and the filled half is handed to the callback on
+ * the system work queue. If that half is still waiting for the previous
+ * callback, its data is dropped and counted in overruns(), so the buffer
+ * the callback is reading is never overwritten.
+ *
+ * Re-arming from the interrupt relies on SPI_LOCK_ON, so the bus is
+ * reserved for the stream until end(). The driver cannot abort a transfer
+ * in peripheral mode, so end() blocks until the one armed at that time
+ * completes with the next frame from the controller. The buffer can be
+ * reused once end() returns.
+ */
+class SPIPeripheralStream {
+public:
+	SPIPeripheralStream(ZephyrSPI &spi);
+
+	/* `buffer` must hold 2 * `count` bytes */
+	int begin(SPISettings settings, uint8_t *buffer, size_t count, SPIStreamCallback cb);
+	void end();
+
+	uint32_t overruns() const {
+		return _overruns;
+	}
+
+private:
+	int arm(size_t half);
+	static void done(const struct device *dev, int result, void *data);
+	static void deliver(struct k_work *work);
+
+	struct deliver_work {
+		struct k_work work;
+		SPIPeripheralStream *stream;
+	};
+
+	ZephyrSPI &_spi;
+	struct spi_config _config = {};
+	struct spi_buf _rx_buf = {};
+	struct spi_buf_set _rx_set = {};
+	uint8_t *_buffer = nullptr;
+	size_t _count = 0;
+	size_t _half = 0;
+	int _len[2] = {};
+	SPIStreamCallback _cb = nullptr;
+	atomic_t _pending = ATOMIC_INIT(0);
+	/* Between a successful begin() and end() */
+	bool _started = false;
+	volatile bool _running = false;
+	/* A transfer into the buffer is pending in the driver */
+	volatile bool _armed = false;
+	uint32_t _overruns = 0;
+	struct deliver_work _deliver;
+	struct k_sem _idle;
+};
+#endif
+
 } // namespace arduino
 
 #if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), spis) && (DT_PROP_LEN(DT_PATH(zephyr_user), spis) > 1)
@@ -96,3 +354,6 @@ using arduino::SPI_MODE1;
 using arduino::SPI_MODE2;
 using arduino::SPI_MODE3;
 using arduino::SPISettings;
+#ifdef CONFIG_SPI_ASYNC
+using arduino::SPIPeripheralStream;
+#endif
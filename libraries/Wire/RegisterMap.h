@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Wire.h>
+
+namespace arduino {
+
+enum RegisterType {
+	// Only changed by writes from the sketch: read from the device once
+	REGISTER_CACHED,
+	// Changed by the device, such as status or data: always read from the device
+	REGISTER_VOLATILE,
+	// Cannot be read back: reads return the last value written
+	REGISTER_WRITE_ONLY,
+};
+
+/*
+ * Shadow copy of N registers of one I2C device, starting at register first.
+ *
+ * Only declared registers can be accessed. write() and update() change
+ * the copy and mark the register dirty. flush() sends all dirty registers
+ * with as few writeRegisters() bursts as possible. Clean cached registers
+ * between two dirty ones are sent again with their known value, so that
+ * the run does not need to be split. Write-only registers are often
+ * commands, so they are only written when dirty themselves. This relies
+ * on the device incrementing the register address during a burst, as most
+ * sensors do.
+ *
+ * update() on a cached register only touches the bus the first time, so a
+ * read-modify-write becomes a single write at the next flush().
+ *
+ * Like Wire itself, a map is meant to be used from one thread.
+ */
+template <size_t N> class RegisterMap {
+	static_assert(N > 0 && N <= 256, "A device has at most 256 registers");
+
+public:
+	RegisterMap(ZephyrI2C &i2c, uint8_t address, uint8_t first = 0)
+		: _i2c(i2c), _address(address), _first(first) {
+	}
+
+	/* The value is the initial content of write-only registers */
+	int declare(uint8_t reg, RegisterType type, uint8_t value = 0) {
+		size_t i = (uint8_t)(reg - _first);
+
+		if (reg < _first || i >= N) {
+			return -EINVAL;
+		}
+
+		_values[i] = value;
+		_flags[i] = FLAG_DECLARED | type;
+		if (type == REGISTER_WRITE_ONLY) {
+			_flags[i] |= FLAG_VALID;
+		}
+
+		return 0;
+	}
+
+	/* Returns the register value, or a negative error code */
+	int read(uint8_t reg) {
+		int i = index(reg);
+		uint8_t value;
+		int ret;
+
+		if (i < 0) {
+			return i;
+		}
+
+		if (type(i) != REGISTER_VOLATILE && (_flags[i] & FLAG_VALID)) {
+			return _values[i];
+		}
+
+		ret = _i2c.readRegisters(_address, reg, &value, 1);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (type(i) == REGISTER_CACHED) {
+			_values[i] = value;
+			_flags[i] |= FLAG_VALID;
+		}
+
+		return value;
+	}
+
+	int write(uint8_t reg, uint8_t value) {
+		int i = index(reg);
+
+		if (i < 0) {
+			return i;
+		}
+
+		_values[i] = value;
+		_flags[i] |= FLAG_DIRTY;
+		if (type(i) != REGISTER_VOLATILE) {
+			_flags[i] |= FLAG_VALID;
+		}
+
+		return 0;
+	}
+
+	/* Replaces the bits in mask with those of value */
+	int update(uint8_t reg, uint8_t mask, uint8_t value) {
+		int old = read(reg);
+		uint8_t val;
+
+		if (old < 0) {
+			return old;
+		}
+
+		val = (old & ~mask) | (value & mask);
+		if (val == old && type(index(reg)) != REGISTER_VOLATILE) {
+			return 0;
+		}
+
+		return write(reg, val);
+	}
+
+	/* Sends the dirty registers to the device */
+	int flush() {
+		size_t i = 0;
+
+		while (i < N) {
+			size_t start = i, end = i + 1;
+			int ret;
+
+			if (!(_flags[i] & FLAG_DIRTY)) {
+				i++;
+				continue;
+			}
+
+			for (size_t j = start + 1; j < N; j++) {
+				if (_flags[j] & FLAG_DIRTY) {
+					end = j + 1;
+				} else if (!known(j)) {
+					break;
+				}
+			}
+
+			ret = _i2c.writeRegisters(_address, _first + start, &_values[start], end - start);
+			if (ret < 0) {
+				return ret;
+			}
+
+			for (size_t j = start; j < end; j++) {
+				_flags[j] &= ~FLAG_DIRTY;
+			}
+			i = end;
+		}
+
+		return 0;
+	}
+
+	/* Reloads the clean cached registers, one burst per run of them */
+	int refresh() {
+		size_t i = 0;
+
+		while (i < N) {
+			size_t start = i, end = i;
+			int ret;
+
+			while (end < N && type(end) == REGISTER_CACHED && (_flags[end] & FLAG_DECLARED) &&
+				   !(_flags[end] & FLAG_DIRTY)) {
+				end++;
+			}
+
+			if (end == start) {
+				i++;
+				continue;
+			}
+
+			ret = _i2c.readRegisters(_address, _first + start, &_values[start], end - start);
+			if (ret < 0) {
+				return ret;
+			}
+
+			for (size_t j = start; j < end; j++) {
+				_flags[j] |= FLAG_VALID;
+			}
+			i = end;
+		}
+
+		return 0;
+	}
+
+	/* Forgets the cached values, for example after a reset of the device */
+	void invalidate() {
+		for (size_t i = 0; i < N; i++) {
+			if (type(i) == REGISTER_CACHED && !(_flags[i] & FLAG_DIRTY)) {
+				_flags[i] &= ~FLAG_VALID;
+			}
+		}
+	}
+
+	bool dirty() const {
+		for (size_t i = 0; i < N; i++) {
+			if (_flags[i] & FLAG_DIRTY) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+private:
+	enum {
+		FLAG_TYPE = 0x03,
+		FLAG_DECLARED = BIT(2),
+		FLAG_VALID = BIT(3),
+		FLAG_DIRTY = BIT(4),
+	};
+
+	int index(uint8_t reg) const {
+		size_t i = (uint8_t)(reg - _first);
+
+		if (reg < _first || i >= N || !(_flags[i] & FLAG_DECLARED)) {
+			return -EINVAL;
+		}
+
+		return i;
+	}
+
+	RegisterType type(size_t i) const {
+		return static_cast<RegisterType>(_flags[i] & FLAG_TYPE);
+	}
+
+	/* Can be written again with the value in the copy, without side effects */
+	bool known(size_t i) const {
+		return (_flags[i] & FLAG_DECLARED) && (_flags[i] & FLAG_VALID) &&
+			   type(i) == REGISTER_CACHED;
+	}
+
+	ZephyrI2C &_i2c;
+	uint8_t _address;
+	uint8_t _first;
+	uint8_t _values[N] = {};
+	uint8_t _flags[N] = {};
+};
+
+} // namespace arduino
+
+using arduino::RegisterMap;
@@ -42,18 +42,42 @@ static int i2c_target_read_processed_cb(struct i2c_target_config *config, uint8_
 	return instance->readProcessedCallback(config, val);
 }
 
+#ifdef CONFIG_I2C_TARGET_BUFFER_MODE
+static void i2c_target_buf_write_received_cb(struct i2c_target_config *config, uint8_t *ptr,
+											 uint32_t len) {
+	arduino::ZephyrI2C *instance = getInstance(config);
+	instance->bufWriteReceivedCallback(config, ptr, len);
+}
+
+static int i2c_target_buf_read_requested_cb(struct i2c_target_config *config, uint8_t **ptr,
+											uint32_t *len) {
+	arduino::ZephyrI2C *instance = getInstance(config);
+	return instance->bufReadRequestedCallback(config, ptr, len);
+}
+#endif
+
 // I2C target callback structure.
 static struct i2c_target_callbacks target_callbacks = {
 	.write_requested = i2c_target_write_requested_cb,
 	.read_requested = i2c_target_read_requested_cb,
 	.write_received = i2c_target_write_received_cb,
 	.read_processed = i2c_target_read_processed_cb,
+#ifdef CONFIG_I2C_TARGET_BUFFER_MODE
+	.buf_write_received = i2c_target_buf_write_received_cb,
+	.buf_read_requested = i2c_target_buf_read_requested_cb,
+#endif
 	.stop = i2c_target_stop_cb,
 };
 
 arduino::ZephyrI2C::ZephyrI2C(const struct device *i2c) : i2c_cfg({0}), i2c_dev(i2c) {
 	ring_buf_init(&txRingBuffer.rb, sizeof(txRingBuffer.buffer), txRingBuffer.buffer);
 	ring_buf_init(&rxRingBuffer.rb, sizeof(rxRingBuffer.buffer), rxRingBuffer.buffer);
+	k_mutex_init(&busLock);
+#ifdef CONFIG_I2C_CALLBACK
+	k_sem_init(&asyncIdle, 1, 1);
+#endif
+	k_work_init(&targetWork.work, runTargetCallbacks);
+	targetWork.i2c = this;
 }
 
 void arduino::ZephyrI2C::begin() {
@@ -92,23 +116,47 @@ void arduino::ZephyrI2C::setClock(uint32_t freq) {
 }
 
 void arduino::ZephyrI2C::beginTransmission(uint8_t address) {
+	k_mutex_lock(&busLock, K_FOREVER);
+
+	// A write to the same address goes out after the deferred one,
+	// behind a repeated start, so its bytes stay in the ring.
+	if (writePending && address != pendingAddress) {
+		flushPendingWrite();
+	}
+	if (!writePending) {
+		ring_buf_reset(&txRing()->rb);
+	}
+
 	_address = address;
-	ring_buf_reset(&txRingBuffer.rb);
-	ring_buf_reset(&rxRingBuffer.rb);
+	ring_buf_reset(&rxRing()->rb);
 }
 
 uint8_t arduino::ZephyrI2C::endTransmission(bool stopBit) {
-	int ret = -EIO;
+	int ret;
 	uint8_t *buf = NULL;
-	size_t max = ring_buf_capacity_get(&txRingBuffer.rb);
-	size_t len = ring_buf_get_claim(&txRingBuffer.rb, &buf, max);
+	struct ring_buf *tx = &txRing()->rb;
+	struct i2c_msg msg;
+
+	if (!stopBit && !writePending) {
+		// Defer the write so that it is sent with the next transfer, with a
+		// repeated start in between. Claiming it now keeps the bytes written
+		// for the next transfer behind it in the ring.
+		pendingLen = ring_buf_get_claim(tx, &pendingBuf, ring_buf_capacity_get(tx));
+		pendingAddress = _address;
+		writePending = true;
+		unlockBus(false);
+		return 0;
+	}
 
-	ARG_UNUSED(stopBit);
+	size_t max = ring_buf_capacity_get(tx);
+	size_t len = ring_buf_get_claim(tx, &buf, max);
 
-	ret = i2c_write(i2c_dev, buf, len, _address);
+	msg.buf = buf;
+	msg.len = len;
+	msg.flags = I2C_MSG_WRITE;
+	ret = transfer(_address, &msg, 1, stopBit, len);
 
-	// Must be called even if 0 bytes claimed.
-	ring_buf_get_finish(&txRingBuffer.rb, len);
+	unlockBus(stopBit);
 
 	return ret ? 1 : 0;
 }
@@ -118,19 +166,21 @@ uint8_t arduino::ZephyrI2C::endTransmission(void) {
 }
 
 size_t arduino::ZephyrI2C::requestFrom(uint8_t address, size_t len_in, bool stopBit) {
-	int ret = -EIO;
+	int ret;
 	uint8_t *buf = NULL;
+	struct ring_buf *rx;
 	size_t len;
 
-	ARG_UNUSED(stopBit);
+	k_mutex_lock(&busLock, K_FOREVER);
 
-	len = ring_buf_put_claim(&rxRingBuffer.rb, &buf, len_in);
-	if (len && buf) {
-		ret = i2c_read(i2c_dev, buf, len, address);
-	}
+	rx = &rxRing()->rb;
+	len = ring_buf_put_claim(rx, &buf, len_in);
+	ret = transferMessage(address, buf, len, I2C_MSG_READ, stopBit);
 
 	// Must be called even if 0 bytes claimed.
-	ring_buf_put_finish(&rxRingBuffer.rb, len);
+	ring_buf_put_finish(rx, ret ? 0 : len);
+
+	unlockBus(stopBit);
 
 	return ret ? 0 : len;
 }
@@ -139,29 +189,184 @@ size_t arduino::ZephyrI2C::requestFrom(uint8_t address, size_t len) {
 	return requestFrom(address, len, true);
 }
 
+size_t arduino::ZephyrI2C::requestFrom(uint8_t address, uint8_t *buffer, size_t len) {
+	int ret;
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	ret = transferMessage(address, buffer, len, I2C_MSG_READ, true);
+	unlockBus(true);
+
+	return ret ? 0 : len;
+}
+
+size_t arduino::ZephyrI2C::write(uint8_t address, const uint8_t *buffer, size_t len) {
+	int ret;
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	ret = transferMessage(address, const_cast<uint8_t *>(buffer), len, I2C_MSG_WRITE, true);
+	unlockBus(true);
+
+	return ret ? 0 : len;
+}
+
+#ifdef CONFIG_I2C_CALLBACK
+arduino::I2CAsyncTransfer::I2CAsyncTransfer() {
+	k_sem_init(&complete, 0, 1);
+}
+
+bool arduino::I2CAsyncTransfer::poll() {
+	return !atomic_get(&busy);
+}
+
+int arduino::I2CAsyncTransfer::wait() {
+	if (!poll()) {
+		k_sem_take(&complete, K_FOREVER);
+	}
+
+	return _result;
+}
+
+void arduino::I2CAsyncTransfer::done(const struct device *dev, int result, void *data) {
+	I2CAsyncTransfer *xfer = static_cast<I2CAsyncTransfer *>(data);
+
+	ARG_UNUSED(dev);
+
+	xfer->_result = result;
+	// Let synchronous transfers on the bus go ahead
+	k_sem_give(xfer->busIdle);
+
+	if (xfer->cb) {
+		xfer->cb(result, xfer->arg);
+	}
+
+	atomic_clear(&xfer->busy);
+	k_sem_give(&xfer->complete);
+}
+
+int arduino::ZephyrI2C::transferAsync(uint8_t address, const uint8_t *tx, size_t txLen,
+									  uint8_t *rx, size_t rxLen, I2CAsyncTransfer &xfer,
+									  I2CAsyncCallback cb, void *arg) {
+	uint8_t num = 0;
+	int ret;
+
+	if ((!tx || !txLen) && (!rx || !rxLen)) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&xfer.busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	if (tx && txLen) {
+		xfer.msgs[num].buf = const_cast<uint8_t *>(tx);
+		xfer.msgs[num].len = txLen;
+		xfer.msgs[num].flags = I2C_MSG_WRITE;
+		num++;
+	}
+
+	if (rx && rxLen) {
+		xfer.msgs[num].buf = rx;
+		xfer.msgs[num].len = rxLen;
+		xfer.msgs[num].flags = I2C_MSG_READ | (num ? I2C_MSG_RESTART : 0);
+		num++;
+	}
+
+	xfer.msgs[num - 1].flags |= I2C_MSG_STOP;
+	xfer.cb = cb;
+	xfer.arg = arg;
+	xfer.busIdle = &asyncIdle;
+	k_sem_reset(&xfer.complete);
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	if (writePending) {
+		flushPendingWrite();
+	}
+
+	// Reserve the controller until the completion callback
+	k_sem_take(&asyncIdle, K_FOREVER);
+	ret = i2c_transfer_cb(i2c_dev, xfer.msgs, num, address, I2CAsyncTransfer::done, &xfer);
+	if (ret < 0) {
+		k_sem_give(&asyncIdle);
+		xfer._result = ret;
+		atomic_clear(&xfer.busy);
+	}
+
+	busOpen = false;
+	unlockBus(true);
+
+	return ret;
+}
+#endif
+
+int arduino::ZephyrI2C::readRegisters(uint8_t address, uint8_t reg, uint8_t *buf, size_t len) {
+	struct i2c_msg msgs[2];
+	int ret;
+
+	if (!buf || !len) {
+		return -EINVAL;
+	}
+
+	msgs[0].buf = &reg;
+	msgs[0].len = 1;
+	msgs[0].flags = I2C_MSG_WRITE;
+	msgs[1].buf = buf;
+	msgs[1].len = len;
+	msgs[1].flags = I2C_MSG_READ | I2C_MSG_RESTART;
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	ret = transfer(address, msgs, 2, true);
+	unlockBus(true);
+
+	return ret;
+}
+
+int arduino::ZephyrI2C::writeRegisters(uint8_t address, uint8_t reg, const uint8_t *buf,
+									   size_t len) {
+	struct i2c_msg msgs[2];
+	int ret;
+
+	if (!buf || !len) {
+		return -EINVAL;
+	}
+
+	// The data follows the register address in the same write, no restart
+	msgs[0].buf = &reg;
+	msgs[0].len = 1;
+	msgs[0].flags = I2C_MSG_WRITE;
+	msgs[1].buf = const_cast<uint8_t *>(buf);
+	msgs[1].len = len;
+	msgs[1].flags = I2C_MSG_WRITE;
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	ret = transfer(address, msgs, 2, true);
+	unlockBus(true);
+
+	return ret;
+}
+
 size_t arduino::ZephyrI2C::write(uint8_t data) {
-	return ring_buf_put(&txRingBuffer.rb, &data, 1);
+	return ring_buf_put(&txRing()->rb, &data, 1);
 }
 
 size_t arduino::ZephyrI2C::write(const uint8_t *buffer, size_t size) {
-	return ring_buf_put(&txRingBuffer.rb, buffer, size);
+	return ring_buf_put(&txRing()->rb, buffer, size);
 }
 
 int arduino::ZephyrI2C::read() {
 	uint8_t buf;
-	if (ring_buf_get(&rxRingBuffer.rb, &buf, 1)) {
+	if (ring_buf_get(&rxRing()->rb, &buf, 1)) {
 		return (int)buf;
 	}
 	return -1;
 }
 
 int arduino::ZephyrI2C::available() {
-	return ring_buf_size_get(&rxRingBuffer.rb);
+	return ring_buf_size_get(&rxRing()->rb);
 }
 
 int arduino::ZephyrI2C::peek() {
 	uint8_t buf;
-	if (ring_buf_peek(&rxRingBuffer.rb, &buf, 1)) {
+	if (ring_buf_peek(&rxRing()->rb, &buf, 1)) {
 		return (int)buf;
 	}
 	return -1;
@@ -178,11 +383,238 @@ void arduino::ZephyrI2C::onRequest(voidFuncPtr cb) {
 	onRequestCb = cb;
 }
 
+void arduino::ZephyrI2C::deferTargetCallbacks(bool defer) {
+	deferCallbacks = defer;
+}
+
+int arduino::ZephyrI2C::setThreadBuffers(struct i2c_ring *tx, struct i2c_ring *rx) {
+#if CONFIG_ARDUINO_WIRE_THREAD_BUFFERS > 0
+	k_tid_t self = k_current_get();
+	int ret = -ENOMEM;
+
+	if (!tx || !rx) {
+		return -EINVAL;
+	}
+
+	clearThreadBuffers();
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	for (auto &entry : threadBuffers) {
+		if (entry.thread == NULL) {
+			ring_buf_init(&tx->rb, sizeof(tx->buffer), tx->buffer);
+			ring_buf_init(&rx->rb, sizeof(rx->buffer), rx->buffer);
+			entry.tx = tx;
+			entry.rx = rx;
+			entry.thread = self;
+			ret = 0;
+			break;
+		}
+	}
+	k_mutex_unlock(&busLock);
+
+	return ret;
+#else
+	ARG_UNUSED(tx);
+	ARG_UNUSED(rx);
+	return -ENOTSUP;
+#endif
+}
+
+void arduino::ZephyrI2C::clearThreadBuffers() {
+#if CONFIG_ARDUINO_WIRE_THREAD_BUFFERS > 0
+	k_tid_t self = k_current_get();
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	for (auto &entry : threadBuffers) {
+		if (entry.thread == self) {
+			entry.thread = NULL;
+		}
+	}
+	k_mutex_unlock(&busLock);
+#endif
+}
+
+struct arduino::i2c_ring *arduino::ZephyrI2C::txRing() {
+#if CONFIG_ARDUINO_WIRE_THREAD_BUFFERS > 0
+	// Target mode callbacks run in interrupt context and use the bus buffers
+	if (!k_is_in_isr()) {
+		k_tid_t self = k_current_get();
+
+		for (auto &entry : threadBuffers) {
+			if (entry.thread == self) {
+				return entry.tx;
+			}
+		}
+	}
+#endif
+	return &txRingBuffer;
+}
+
+struct arduino::i2c_ring *arduino::ZephyrI2C::rxRing() {
+#if CONFIG_ARDUINO_WIRE_THREAD_BUFFERS > 0
+	if (!k_is_in_isr()) {
+		k_tid_t self = k_current_get();
+
+		for (auto &entry : threadBuffers) {
+			if (entry.thread == self) {
+				return entry.rx;
+			}
+		}
+	}
+#endif
+	return &rxRingBuffer;
+}
+
+void arduino::ZephyrI2C::releaseRestart() {
+	if (restartPending) {
+		restartPending = false;
+		k_mutex_unlock(&busLock);
+	}
+}
+
+void arduino::ZephyrI2C::unlockBus(bool stopBit) {
+	if (!stopBit && !restartPending) {
+		// Keep this lock until the transfer that sends the stop
+		restartPending = true;
+		return;
+	}
+
+	k_mutex_unlock(&busLock);
+	if (stopBit) {
+		releaseRestart();
+	}
+}
+
+int arduino::ZephyrI2C::setBuffers(uint8_t *tx, size_t txSize, uint8_t *rx, size_t rxSize) {
+	if ((tx && !txSize) || (rx && !rxSize)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&busLock, K_FOREVER);
+	if (writePending) {
+		flushPendingWrite();
+	}
+
+	// NULL goes back to the buffers built into the bus
+	if (tx) {
+		ring_buf_init(&txRingBuffer.rb, txSize, tx);
+	} else {
+		ring_buf_init(&txRingBuffer.rb, sizeof(txRingBuffer.buffer), txRingBuffer.buffer);
+	}
+
+	if (rx) {
+		ring_buf_init(&rxRingBuffer.rb, rxSize, rx);
+	} else {
+		ring_buf_init(&rxRingBuffer.rb, sizeof(rxRingBuffer.buffer), rxRingBuffer.buffer);
+	}
+	k_mutex_unlock(&busLock);
+
+	return 0;
+}
+
+int arduino::ZephyrI2C::transferMessage(uint8_t address, uint8_t *buf, size_t len, uint8_t flags,
+										bool stopBit) {
+	struct i2c_msg msg;
+
+	if (len == 0 || buf == NULL) {
+		if (writePending) {
+			flushPendingWrite();
+		}
+		return -EINVAL;
+	}
+
+	msg.buf = buf;
+	msg.len = len;
+	msg.flags = flags;
+
+	return transfer(address, &msg, 1, stopBit);
+}
+
+int arduino::ZephyrI2C::transfer(uint8_t address, const struct i2c_msg *msgs, uint8_t num,
+								 bool stopBit, size_t txClaimed) {
+	struct i2c_msg all[WIRE_MAX_MESSAGES];
+	uint8_t count = 0;
+	uint8_t first;
+	int ret;
+
+	if (num >= WIRE_MAX_MESSAGES) {
+		return -EINVAL;
+	}
+
+	if (writePending && address != pendingAddress) {
+		flushPendingWrite();
+	}
+
+	if (writePending && pendingLen) {
+		all[count].buf = pendingBuf;
+		all[count].len = pendingLen;
+		all[count].flags = I2C_MSG_WRITE;
+		count++;
+	}
+
+	first = count;
+	for (uint8_t i = 0; i < num; i++) {
+		// Empty messages only go out alone, as an address probe
+		if (msgs[i].len == 0 && (count || i + 1 < num)) {
+			continue;
+		}
+
+		all[count] = msgs[i];
+		if (first && count == first) {
+			// Repeated start between the deferred write and the new message
+			all[count].flags |= I2C_MSG_RESTART;
+		}
+		count++;
+	}
+
+	if (count == 0) {
+		// A deferred empty write with nothing to follow it
+		all[0].buf = pendingBuf;
+		all[0].len = 0;
+		all[0].flags = I2C_MSG_WRITE;
+		count = 1;
+	}
+
+	if (busOpen) {
+		all[0].flags |= I2C_MSG_RESTART;
+	}
+
+	// Without CONFIG_I2C_ALLOW_NO_STOP_TRANSACTIONS Zephyr always ends
+	// a transfer with a stop, the bus is then only held for this thread.
+	if (stopBit || !IS_ENABLED(CONFIG_I2C_ALLOW_NO_STOP_TRANSACTIONS)) {
+		all[count - 1].flags |= I2C_MSG_STOP;
+	}
+
+#ifdef CONFIG_I2C_CALLBACK
+	k_sem_take(&asyncIdle, K_FOREVER);
+	ret = i2c_transfer(i2c_dev, all, count, address);
+	k_sem_give(&asyncIdle);
+#else
+	ret = i2c_transfer(i2c_dev, all, count, address);
+#endif
+	busOpen = (ret == 0) && !(all[count - 1].flags & I2C_MSG_STOP);
+
+	if (writePending || txClaimed) {
+		// Claims on the ring add up, finish them at once
+		ring_buf_get_finish(&txRing()->rb, (writePending ? pendingLen : 0) + txClaimed);
+		writePending = false;
+	}
+
+	return ret;
+}
+
+int arduino::ZephyrI2C::flushPendingWrite() {
+	return transfer(pendingAddress, NULL, 0, true);
+}
+
 int arduino::ZephyrI2C::writeRequestedCallback(struct i2c_target_config *config) {
 	ARG_UNUSED(config);
 
-	// Reset the buffer on write requests.
-	ring_buf_reset(&rxRingBuffer.rb);
+	// Reset the buffer on write requests. A deferred onReceive() may still
+	// be reading it, so in that case new bytes are added after the old ones.
+	if (!deferCallbacks) {
+		ring_buf_reset(&rxRingBuffer.rb);
+	}
 	return 0;
 }
 
@@ -194,7 +626,7 @@ int arduino::ZephyrI2C::writeReceivedCallback(struct i2c_target_config *config,
 
 	// If the buffer is about to overflow, invoke the callback
 	// with the current length.
-	if (onReceiveCb && ((len + 1) > max)) {
+	if (onReceiveCb && !deferCallbacks && ((len + 1) > max)) {
 		onReceiveCb(len);
 	}
 
@@ -202,12 +634,7 @@ int arduino::ZephyrI2C::writeReceivedCallback(struct i2c_target_config *config,
 }
 
 int arduino::ZephyrI2C::readRequestedCallback(struct i2c_target_config *config, uint8_t *val) {
-	// Reset the buffer on read requests.
-	ring_buf_reset(&txRingBuffer.rb);
-
-	if (onRequestCb) {
-		onRequestCb();
-	}
+	prepareTargetReply();
 
 	return readProcessedCallback(config, val);
 }
@@ -222,20 +649,236 @@ int arduino::ZephyrI2C::readProcessedCallback(struct i2c_target_config *config,
 	return 0;
 }
 
+#ifdef CONFIG_I2C_TARGET_BUFFER_MODE
+void arduino::ZephyrI2C::bufWriteReceivedCallback(struct i2c_target_config *config, uint8_t *ptr,
+												  uint32_t len) {
+	size_t space = ring_buf_space_get(&rxRingBuffer.rb);
+
+	ARG_UNUSED(config);
+
+	// Same as writeReceivedCallback() for a whole block: let the sketch
+	// drain the buffer first if the block does not fit.
+	if (onReceiveCb && !deferCallbacks && len > space) {
+		onReceiveCb(ring_buf_size_get(&rxRingBuffer.rb));
+	}
+
+	ring_buf_put(&rxRingBuffer.rb, ptr, len);
+}
+
+int arduino::ZephyrI2C::bufReadRequestedCallback(struct i2c_target_config *config, uint8_t **ptr,
+												 uint32_t *len) {
+	ARG_UNUSED(config);
+
+	if (targetTxClaimed) {
+		ring_buf_get_finish(&txRingBuffer.rb, targetTxClaimed);
+	}
+
+	prepareTargetReply();
+
+	// Hand the reply to the driver in place, it is released at the stop
+	targetTxClaimed =
+		ring_buf_get_claim(&txRingBuffer.rb, ptr, ring_buf_capacity_get(&txRingBuffer.rb));
+	*len = targetTxClaimed;
+
+	return 0;
+}
+#endif
+
 int arduino::ZephyrI2C::stopCallback(struct i2c_target_config *config) {
 	ARG_UNUSED(config);
 
+#ifdef CONFIG_I2C_TARGET_BUFFER_MODE
+	if (targetTxClaimed) {
+		ring_buf_get_finish(&txRingBuffer.rb, targetTxClaimed);
+		targetTxClaimed = 0;
+	}
+#endif
+
 	// If the RX buffer is not empty invoke the callback with the
 	// remaining data length.
 	if (onReceiveCb) {
 		size_t len = ring_buf_size_get(&rxRingBuffer.rb);
 		if (len) {
-			onReceiveCb(len);
+			if (deferCallbacks) {
+				atomic_or(&targetEvents, TARGET_EVENT_RECEIVED);
+			} else {
+				onReceiveCb(len);
+			}
 		}
 	}
+
+	if (atomic_get(&targetEvents)) {
+		k_work_submit(&targetWork.work);
+	}
 	return 0;
 }
 
+void arduino::ZephyrI2C::prepareTargetReply() {
+	if (deferCallbacks) {
+		// Send what was prepared before, and refill the buffer for the
+		// next read once this one is over.
+		if (onRequestCb) {
+			atomic_or(&targetEvents, TARGET_EVENT_REQUESTED);
+		}
+		return;
+	}
+
+	// Reset the buffer on read requests.
+	ring_buf_reset(&txRingBuffer.rb);
+
+	if (onRequestCb) {
+		onRequestCb();
+	}
+}
+
+void arduino::ZephyrI2C::runTargetCallbacks(struct k_work *work) {
+	ZephyrI2C *i2c = CONTAINER_OF(work, struct target_work, work)->i2c;
+	atomic_val_t events = atomic_clear(&i2c->targetEvents);
+
+	if ((events & TARGET_EVENT_RECEIVED) && i2c->onReceiveCb) {
+		size_t len = ring_buf_size_get(&i2c->rxRingBuffer.rb);
+
+		if (len) {
+			i2c->onReceiveCb(len);
+		}
+	}
+
+	if ((events & TARGET_EVENT_REQUESTED) && i2c->onRequestCb) {
+		// Drop what is left of the previous reply. The target interrupt
+		// reads the same buffer, so keep it out while resetting, and leave
+		// a reply lent to the driver for a read in progress alone.
+		unsigned int key = irq_lock();
+#ifdef CONFIG_I2C_TARGET_BUFFER_MODE
+		if (!i2c->targetTxClaimed)
+#endif
+		{
+			ring_buf_reset(&i2c->txRingBuffer.rb);
+		}
+		irq_unlock(key);
+
+		i2c->onRequestCb();
+	}
+}
+
+#ifdef CONFIG_I2C_CALLBACK
+arduino::I2CPoller::I2CPoller(ZephyrI2C &i2c) : _i2c(i2c) {
+	k_mutex_init(&_lock);
+	k_work_init_delayable(&_run.work, run);
+	_run.poller = this;
+}
+
+int arduino::I2CPoller::add(I2CPoll &poll, uint8_t address, uint8_t reg, uint8_t *buf,
+							size_t len, unsigned long periodMs, I2CPollCallback cb, void *arg) {
+	if (!buf || !len || !periodMs || !cb) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&_lock, K_FOREVER);
+	if (poll.poller) {
+		k_mutex_unlock(&_lock);
+		return -EBUSY;
+	}
+
+	poll.poller = this;
+	poll.address = address;
+	poll.reg = reg;
+	poll.buf = buf;
+	poll.len = len;
+	poll.period = periodMs;
+	poll.due = k_uptime_get();
+	poll.cb = cb;
+	poll.arg = arg;
+	poll._overruns = 0;
+	atomic_clear(&poll.ready);
+
+	// Append, earlier polls go first when several are due
+	I2CPoll **tail = &_polls;
+	while (*tail) {
+		tail = &(*tail)->next;
+	}
+	poll.next = nullptr;
+	*tail = &poll;
+	k_mutex_unlock(&_lock);
+
+	k_work_reschedule(&_run.work, K_NO_WAIT);
+	return 0;
+}
+
+int arduino::I2CPoller::remove(I2CPoll &poll) {
+	k_mutex_lock(&_lock, K_FOREVER);
+	if (poll.poller != this) {
+		k_mutex_unlock(&_lock);
+		return -EINVAL;
+	}
+
+	for (I2CPoll **p = &_polls; *p; p = &(*p)->next) {
+		if (*p == &poll) {
+			*p = poll.next;
+			break;
+		}
+	}
+	k_mutex_unlock(&_lock);
+
+	// The buffer belongs to the read in progress until it is over
+	poll.xfer.wait();
+	poll.poller = nullptr;
+	return 0;
+}
+
+void arduino::I2CPoller::done(int result, void *arg) {
+	I2CPoll *poll = static_cast<I2CPoll *>(arg);
+	I2CPoller *poller = poll->poller;
+
+	ARG_UNUSED(result);
+
+	atomic_set(&poll->ready, 1);
+	atomic_clear(&poller->_busy);
+	k_work_reschedule(&poller->_run.work, K_NO_WAIT);
+}
+
+void arduino::I2CPoller::run(struct k_work *work) {
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	I2CPoller *poller = CONTAINER_OF(dwork, struct run_work, work)->poller;
+	int64_t now, wake = INT64_MAX;
+
+	k_mutex_lock(&poller->_lock, K_FOREVER);
+
+	for (I2CPoll *poll = poller->_polls; poll; poll = poll->next) {
+		if (atomic_cas(&poll->ready, 1, 0)) {
+			poll->cb(poll->xfer.result(), poll->buf, poll->len, poll->arg);
+		}
+	}
+
+	now = k_uptime_get();
+	for (I2CPoll *poll = poller->_polls; poll; poll = poll->next) {
+		if (poll->due <= now && atomic_cas(&poller->_busy, 0, 1)) {
+			poll->due += poll->period;
+			if (poll->due <= now) {
+				poll->_overruns += (now - poll->due) / poll->period + 1;
+				poll->due = now + poll->period;
+			}
+
+			if (poller->_i2c.transferAsync(poll->address, &poll->reg, 1, poll->buf, poll->len,
+										   poll->xfer, done, poll) < 0) {
+				// Report the error like a completed read
+				atomic_set(&poll->ready, 1);
+				atomic_clear(&poller->_busy);
+				wake = now;
+			}
+		}
+
+		wake = MIN(wake, poll->due);
+	}
+
+	// While a read is in progress its completion schedules the next run
+	if (!atomic_get(&poller->_busy) && wake != INT64_MAX) {
+		k_work_reschedule(dwork, K_MSEC(MAX(wake - now, 0)));
+	}
+
+	k_mutex_unlock(&poller->_lock);
+}
+#endif
+
 #if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), i2cs)
 #if (DT_PROP_LEN(DT_PATH(zephyr_user), i2cs) > 1)
 #define ARDUINO_WIRE_DEFINED_0 1
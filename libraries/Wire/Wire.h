@@ -13,12 +13,50 @@
 
 typedef void (*voidFuncPtrParamInt)(int);
 
+/* Messages in one transfer: a deferred write and up to two more */
+#define WIRE_MAX_MESSAGES 3
+
 namespace arduino {
 
 struct i2c_ring {
 	struct ring_buf rb;
-	uint8_t buffer[256];
+	uint8_t buffer[CONFIG_ARDUINO_WIRE_BUFFER_SIZE];
+};
+
+#ifdef CONFIG_I2C_CALLBACK
+typedef void (*I2CAsyncCallback)(int result, void *arg);
+
+/*
+ * State of one Wire.transferAsync(), owned by the caller. It and the
+ * buffers must stay valid until the transfer is over. The callback runs
+ * in interrupt context.
+ */
+class I2CAsyncTransfer {
+public:
+	I2CAsyncTransfer();
+
+	// True once the transfer is over, without blocking
+	bool poll();
+	// Blocks until the transfer is over and returns its result
+	int wait();
+
+	int result() const {
+		return _result;
+	}
+
+private:
+	friend class ZephyrI2C;
+	static void done(const struct device *dev, int result, void *data);
+
+	struct i2c_msg msgs[2];
+	I2CAsyncCallback cb = nullptr;
+	void *arg = nullptr;
+	atomic_t busy = ATOMIC_INIT(0);
+	int _result = 0;
+	struct k_sem complete;
+	struct k_sem *busIdle;
 };
+#endif
 
 class ZephyrI2C : public HardwareI2C {
 public:
@@ -36,9 +74,41 @@ public:
 	virtual size_t requestFrom(uint8_t address, size_t len, bool stopBit);
 	virtual size_t requestFrom(uint8_t address, size_t len);
 
+	// Complete transfers straight from or into the caller's buffer, bypassing the rings
+	size_t requestFrom(uint8_t address, uint8_t *buffer, size_t len);
+	size_t write(uint8_t address, const uint8_t *buffer, size_t len);
+
+	// Register access in a single transaction, with a repeated start before the read
+	int readRegisters(uint8_t address, uint8_t reg, uint8_t *buf, size_t len);
+	int writeRegisters(uint8_t address, uint8_t reg, const uint8_t *buf, size_t len);
+
+#ifdef CONFIG_I2C_CALLBACK
+	// Writes tx then reads rx after a repeated start, either may be empty. The bus
+	// stays reserved until completion, other transfers wait for it meanwhile.
+	int transferAsync(uint8_t address, const uint8_t *tx, size_t txLen, uint8_t *rx,
+					  size_t rxLen, I2CAsyncTransfer &xfer, I2CAsyncCallback cb = nullptr,
+					  void *arg = nullptr);
+#endif
+
 	virtual void onReceive(void (*)(int));
 	virtual void onRequest(void (*)(void));
 
+	/*
+	 * Run onReceive() and onRequest() from the system work queue instead of
+	 * the interrupt. onReceive() is called after the stop. onRequest() is
+	 * called after each read to prepare the reply to the next one, so the
+	 * first reply must be written before the controller reads. Bytes that
+	 * onReceive() leaves unread are kept and passed again with the next write.
+	 */
+	void deferTargetCallbacks(bool defer);
+
+	// Replace the buffers of the bus, NULL restores the default ones
+	int setBuffers(uint8_t *tx, size_t txSize, uint8_t *rx, size_t rxSize);
+
+	// Use caller provided buffers for transfers started by the calling thread
+	int setThreadBuffers(struct i2c_ring *tx, struct i2c_ring *rx);
+	void clearThreadBuffers();
+
 	virtual size_t write(uint8_t data);
 
 	virtual size_t write(int data) {
@@ -58,20 +128,146 @@ public:
 	int readRequestedCallback(struct i2c_target_config *config, uint8_t *val);
 	int readProcessedCallback(struct i2c_target_config *config, uint8_t *val);
 	int stopCallback(struct i2c_target_config *config);
+#ifdef CONFIG_I2C_TARGET_BUFFER_MODE
+	void bufWriteReceivedCallback(struct i2c_target_config *config, uint8_t *ptr, uint32_t len);
+	int bufReadRequestedCallback(struct i2c_target_config *config, uint8_t **ptr, uint32_t *len);
+#endif
 
 	struct i2c_target_config i2c_cfg;
 
 private:
+	struct i2c_ring *txRing();
+	struct i2c_ring *rxRing();
+	void releaseRestart();
+	void unlockBus(bool stopBit);
+	int transferMessage(uint8_t address, uint8_t *buf, size_t len, uint8_t flags, bool stopBit);
+	int transfer(uint8_t address, const struct i2c_msg *msgs, uint8_t num, bool stopBit,
+				 size_t txClaimed = 0);
+	int flushPendingWrite();
+
 	int _address;
 
 	struct i2c_ring txRingBuffer;
 	struct i2c_ring rxRingBuffer;
 	const struct device *i2c_dev;
 
+	/*
+	 * Held from beginTransmission() to the end of the transfer, and across
+	 * a repeated start until the transfer that sends the stop. While
+	 * restartPending is set the lock is held once more for that purpose.
+	 */
+	struct k_mutex busLock;
+	bool restartPending = false;
+	// The last transfer ended without a stop, the next one starts with a restart
+	bool busOpen = false;
+#ifdef CONFIG_I2C_CALLBACK
+	// Taken for every transfer, and by transferAsync() until it completes
+	struct k_sem asyncIdle;
+#endif
+
+	// Write claimed from the tx ring by endTransmission(false)
+	bool writePending = false;
+	uint8_t pendingAddress;
+	uint8_t *pendingBuf;
+	size_t pendingLen;
+
+#if CONFIG_ARDUINO_WIRE_THREAD_BUFFERS > 0
+	struct {
+		k_tid_t thread;
+		struct i2c_ring *tx;
+		struct i2c_ring *rx;
+	} threadBuffers[CONFIG_ARDUINO_WIRE_THREAD_BUFFERS] = {};
+#endif
+
 	voidFuncPtr onRequestCb = NULL;
 	voidFuncPtrParamInt onReceiveCb = NULL;
+
+	void prepareTargetReply();
+	static void runTargetCallbacks(struct k_work *work);
+
+	enum {
+		TARGET_EVENT_RECEIVED = BIT(0),
+		TARGET_EVENT_REQUESTED = BIT(1),
+	};
+
+	struct target_work {
+		struct k_work work;
+		ZephyrI2C *i2c;
+	} targetWork;
+
+	bool deferCallbacks = false;
+	atomic_t targetEvents = ATOMIC_INIT(0);
+#ifdef CONFIG_I2C_TARGET_BUFFER_MODE
+	// Reply bytes lent to the driver by bufReadRequestedCallback()
+	size_t targetTxClaimed = 0;
+#endif
+};
+
+#ifdef CONFIG_I2C_CALLBACK
+typedef void (*I2CPollCallback)(int result, const uint8_t *data, size_t len, void *arg);
+
+class I2CPoller;
+
+// One periodic register read, owned by the caller while it is polled
+class I2CPoll {
+public:
+	// Reads that started late by a whole period or more, and were skipped
+	unsigned long overruns() const {
+		return _overruns;
+	}
+
+private:
+	friend class I2CPoller;
+
+	I2CPoll *next = nullptr;
+	I2CPoller *poller = nullptr;
+	I2CAsyncTransfer xfer;
+	uint8_t address;
+	uint8_t reg;
+	uint8_t *buf;
+	size_t len;
+	uint32_t period;
+	int64_t due;
+	I2CPollCallback cb;
+	void *arg;
+	atomic_t ready = ATOMIC_INIT(0);
+	unsigned long _overruns = 0;
 };
 
+/*
+ * Reads registers of devices on one bus at fixed rates.
+ *
+ * Reads are issued one at a time with transferAsync() from the system
+ * work queue, in the order the polls were added when several are due.
+ * Results are passed to the callbacks from the work queue as well, so
+ * neither loop() nor the callbacks wait for the bus.
+ */
+class I2CPoller {
+public:
+	I2CPoller(ZephyrI2C &i2c);
+
+	// Reads len bytes from reg every periodMs into buf, starting now
+	int add(I2CPoll &poll, uint8_t address, uint8_t reg, uint8_t *buf, size_t len,
+			unsigned long periodMs, I2CPollCallback cb, void *arg = nullptr);
+	// Waits for a read in progress, no callback is made after it returns
+	int remove(I2CPoll &poll);
+
+private:
+	static void run(struct k_work *work);
+	static void done(int result, void *arg);
+
+	ZephyrI2C &_i2c;
+	I2CPoll *_polls = nullptr;
+	struct k_mutex _lock;
+	atomic_t _busy = ATOMIC_INIT(0);
+
+	struct run_work {
+		struct k_work_delayable work;
+		I2CPoller *poller;
+	} _run;
+};
+#endif
+
 } // namespace arduino
 
 #if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), i2cs) && (DT_PROP_LEN(DT_PATH(zephyr_user), i2cs) > 1)
@@ -228,6 +228,22 @@ FORCE_EXPORT_SYM(shared_multi_heap_alloc);
 EXPORT_SYMBOL(k_timer_init);
 EXPORT_SYMBOL(k_fatal_halt);
 EXPORT_SYMBOL(k_work_schedule);
+EXPORT_SYMBOL(k_work_reschedule);
+EXPORT_SYMBOL(k_work_init_delayable);
+EXPORT_SYMBOL(k_work_init);
+EXPORT_SYMBOL(k_work_submit);
+EXPORT_SYMBOL(k_work_cancel_sync);
+EXPORT_SYMBOL(k_work_cancel);
+EXPORT_SYMBOL(k_work_submit_to_queue);
+EXPORT_SYMBOL(k_work_queue_init);
+EXPORT_SYMBOL(k_work_queue_start);
+EXPORT_SYMBOL(k_msgq_init);
+EXPORT_SYMBOL(k_queue_init);
+EXPORT_SYMBOL(k_queue_append);
+#if defined(CONFIG_SCHED_THREAD_USAGE)
+EXPORT_SYMBOL(k_thread_runtime_stats_get);
+EXPORT_SYMBOL(k_thread_runtime_stats_all_get);
+#endif
 //FORCE_EXPORT_SYM(k_timer_user_data_set);
 //FORCE_EXPORT_SYM(k_timer_start);
 
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <HardwareTimer.h>
+
+#define PERIOD_US 10000
+
+static volatile uint32_t calls;
+
+static void count_call() {
+	calls++;
+}
+
+static void before(void *fixture) {
+	ARG_UNUSED(fixture);
+
+	calls = 0;
+}
+
+ZTEST(hardware_timer, test_periodic) {
+	HardwareTimer timer;
+
+	zassert_ok(timer.begin());
+
+	/* No statistics before the first periodic expiration */
+	zassert_equal(timer.minJitter(), 0);
+	zassert_equal(timer.maxJitter(), 0);
+	zassert_equal(timer.averageJitter(), 0);
+
+	zassert_ok(timer.startPeriodic(PERIOD_US, count_call));
+	k_usleep(10 * PERIOD_US + PERIOD_US / 2);
+	timer.stop();
+
+	zassert_between_inclusive(timer.count(), 9, 11);
+	zassert_equal(calls, timer.count());
+	zassert_true(timer.minJitter() <= timer.maxJitter());
+
+	/* Nothing fires once stopped */
+	k_usleep(3 * PERIOD_US);
+	zassert_equal(calls, timer.count());
+}
+
+ZTEST(hardware_timer, test_one_shot) {
+	HardwareTimer timer;
+
+	zassert_ok(timer.begin());
+	zassert_ok(timer.startOneShot(PERIOD_US, count_call));
+
+	k_usleep(PERIOD_US / 2);
+	zassert_equal(timer.count(), 0, "one-shot fired early");
+
+	k_usleep(5 * PERIOD_US);
+	zassert_equal(timer.count(), 1);
+	zassert_equal(calls, 1);
+}
+
+ZTEST(hardware_timer, test_invalid) {
+	HardwareTimer timer;
+
+	zassert_equal(timer.startPeriodic(PERIOD_US, count_call), -ENODEV, "started without begin()");
+
+	zassert_ok(timer.begin());
+	zassert_equal(timer.startPeriodic(0, count_call), -EINVAL);
+	zassert_equal(timer.startOneShot(PERIOD_US, nullptr), -EINVAL);
+}
+
+ZTEST(hardware_timer, test_claim) {
+	HardwareTimer first, second;
+
+	/* The variant lists a single counter */
+	zassert_ok(first.begin());
+	zassert_equal(second.begin(), -ENODEV);
+
+	first.end();
+	zassert_ok(second.begin());
+	second.end();
+
+	{
+		HardwareTimer scoped;
+
+		zassert_ok(scoped.begin());
+		zassert_ok(scoped.startPeriodic(PERIOD_US, count_call));
+	}
+
+	/* The destructor stopped the counter and handed it back */
+	zassert_ok(first.begin());
+	k_usleep(3 * PERIOD_US);
+	zassert_equal(calls, 0);
+}
+
+ZTEST_SUITE(hardware_timer, NULL, NULL, before, NULL, NULL);
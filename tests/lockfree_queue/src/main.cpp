@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <LockFreeQueue.h>
+
+#define QUEUE_SIZE     8
+#define STRESS_ITEMS   20000
+#define PRODUCERS      3
+#define STACK_SIZE     1024
+
+struct item {
+	uint32_t producer;
+	uint32_t seq;
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, PRODUCERS, STACK_SIZE);
+static struct k_thread producer_threads[PRODUCERS];
+
+static int own_priority(void) {
+	return k_thread_priority_get(k_current_get());
+}
+
+ZTEST(lockfree_queue, test_spsc_push_pop) {
+	SpscQueue<uint32_t, QUEUE_SIZE> q;
+	uint32_t in[QUEUE_SIZE + 2], out[QUEUE_SIZE + 2];
+	uint32_t value;
+
+	zassert_true(q.empty());
+	zassert_false(q.pop(value), "pop from an empty queue");
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(in); i++) {
+		in[i] = i * 7;
+	}
+
+	/* A batch larger than the queue is cut to what fits */
+	zassert_equal(q.push(in, ARRAY_SIZE(in)), QUEUE_SIZE);
+	zassert_equal(q.available(), QUEUE_SIZE);
+	zassert_equal(q.space(), 0);
+	zassert_false(q.push(in[0]), "push to a full queue");
+
+	zassert_equal(q.pop(out, 3), 3);
+	zassert_mem_equal(out, in, 3 * sizeof(uint32_t));
+	zassert_equal(q.space(), 3);
+
+	zassert_equal(q.pop(out, ARRAY_SIZE(out)), QUEUE_SIZE - 3);
+	zassert_mem_equal(out, &in[3], (QUEUE_SIZE - 3) * sizeof(uint32_t));
+	zassert_true(q.empty());
+}
+
+ZTEST(lockfree_queue, test_spsc_wraparound) {
+	SpscQueue<uint32_t, QUEUE_SIZE> q;
+	uint32_t in[5], out[5];
+	uint32_t next = 0, expected = 0;
+
+	/* Batches of 5 through a queue of 8 straddle the end of the array */
+	for (int lap = 0; lap < 100; lap++) {
+		for (uint32_t i = 0; i < ARRAY_SIZE(in); i++) {
+			in[i] = next++;
+		}
+
+		zassert_equal(q.push(in, ARRAY_SIZE(in)), ARRAY_SIZE(in));
+		zassert_equal(q.pop(out, ARRAY_SIZE(out)), ARRAY_SIZE(out));
+
+		for (uint32_t i = 0; i < ARRAY_SIZE(out); i++) {
+			zassert_equal(out[i], expected++);
+		}
+	}
+
+	zassert_true(q.empty());
+}
+
+ZTEST(lockfree_queue, test_spsc_claim_commit) {
+	SpscQueue<uint32_t, QUEUE_SIZE> q;
+	uint32_t value;
+	uint32_t *slots;
+	const uint32_t *items;
+	size_t count;
+
+	/* Move both indices to 6 so that the free space wraps */
+	for (uint32_t i = 0; i < 6; i++) {
+		zassert_true(q.push(i));
+		zassert_true(q.pop(value));
+	}
+
+	count = QUEUE_SIZE;
+	slots = q.claim(count);
+	zassert_not_null(slots);
+	zassert_equal(count, 2, "claim must stop at the end of the array");
+	slots[0] = 100;
+	slots[1] = 101;
+
+	/* Nothing is visible before the commit */
+	zassert_true(q.empty());
+	q.commit(count);
+	zassert_equal(q.available(), 2);
+
+	count = QUEUE_SIZE;
+	slots = q.claim(count);
+	zassert_equal(count, QUEUE_SIZE - 2);
+	for (size_t i = 0; i < count; i++) {
+		slots[i] = 102 + i;
+	}
+	q.commit(count);
+
+	count = 1;
+	zassert_is_null(q.claim(count), "claim on a full queue");
+
+	count = QUEUE_SIZE;
+	items = q.peek(count);
+	zassert_equal(count, 2);
+	zassert_equal(items[0], 100);
+	zassert_equal(items[1], 101);
+	q.release(count);
+
+	count = QUEUE_SIZE;
+	items = q.peek(count);
+	zassert_equal(count, QUEUE_SIZE - 2);
+	for (size_t i = 0; i < count; i++) {
+		zassert_equal(items[i], 102 + i);
+	}
+	q.release(count);
+
+	count = 1;
+	zassert_is_null(q.peek(count), "peek on an empty queue");
+}
+
+ZTEST(lockfree_queue, test_mpsc_push_pop) {
+	MpscQueue<uint32_t, QUEUE_SIZE> q;
+	uint32_t in[QUEUE_SIZE + 1], out[QUEUE_SIZE];
+	uint32_t value;
+
+	zassert_true(q.empty());
+	zassert_false(q.pop(value), "pop from an empty queue");
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(in); i++) {
+		in[i] = i + 1;
+	}
+
+	/* Batches go in whole or not at all */
+	zassert_equal(q.push(in, ARRAY_SIZE(in)), 0);
+	zassert_equal(q.push(in, 5), 5);
+	zassert_equal(q.push(in, 4), 0, "batch larger than the space left");
+	zassert_equal(q.push(in, 3), 3);
+	zassert_false(q.push(in[0]), "push to a full queue");
+
+	zassert_equal(q.pop(out, ARRAY_SIZE(out)), QUEUE_SIZE);
+	zassert_mem_equal(out, in, 5 * sizeof(uint32_t));
+	zassert_mem_equal(&out[5], in, 3 * sizeof(uint32_t));
+	zassert_true(q.empty());
+}
+
+ZTEST(lockfree_queue, test_mpsc_wraparound) {
+	MpscQueue<uint32_t, QUEUE_SIZE> q;
+	uint32_t in[3], out[3];
+	uint32_t next = 0, expected = 0;
+
+	for (int lap = 0; lap < 100; lap++) {
+		for (uint32_t i = 0; i < ARRAY_SIZE(in); i++) {
+			in[i] = next++;
+		}
+
+		zassert_equal(q.push(in, ARRAY_SIZE(in)), ARRAY_SIZE(in));
+		zassert_equal(q.pop(out, ARRAY_SIZE(out)), ARRAY_SIZE(out));
+
+		for (uint32_t i = 0; i < ARRAY_SIZE(out); i++) {
+			zassert_equal(out[i], expected++);
+		}
+	}
+
+	zassert_true(q.empty());
+}
+
+ZTEST(lockfree_queue, test_mpsc_claim_commit) {
+	MpscQueue<uint32_t, QUEUE_SIZE> q;
+	uint32_t *first, *second;
+	const uint32_t *front;
+	uint32_t value;
+
+	first = q.claim();
+	second = q.claim();
+	zassert_not_null(first);
+	zassert_not_null(second);
+
+	/* The later slot is published first, but is held back by the earlier one */
+	*second = 2;
+	q.commit(second);
+	zassert_is_null(q.peek());
+
+	*first = 1;
+	q.commit(first);
+
+	front = q.peek();
+	zassert_not_null(front);
+	zassert_equal(*front, 1);
+	q.release();
+
+	zassert_true(q.pop(value));
+	zassert_equal(value, 2);
+	zassert_true(q.empty());
+
+	for (uint32_t i = 0; i < QUEUE_SIZE; i++) {
+		zassert_not_null(q.claim());
+	}
+	zassert_is_null(q.claim(), "claim on a full queue");
+}
+
+static SpscQueue<struct item, QUEUE_SIZE> spsc_stress;
+
+static void spsc_producer(void *p1, void *p2, void *p3) {
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < STRESS_ITEMS;) {
+		struct item item = {0, seq};
+
+		if (spsc_stress.push(item)) {
+			seq++;
+		} else {
+			k_yield();
+		}
+	}
+}
+
+ZTEST(lockfree_queue, test_spsc_threads) {
+	struct item item;
+	uint32_t expected = 0;
+
+	k_thread_create(&producer_threads[0], producer_stacks[0], STACK_SIZE, spsc_producer, NULL,
+					NULL, NULL, own_priority(), 0, K_NO_WAIT);
+
+	while (expected < STRESS_ITEMS) {
+		if (!spsc_stress.pop(item)) {
+			k_yield();
+			continue;
+		}
+
+		zassert_equal(item.seq, expected, "out of order or lost item");
+		expected++;
+	}
+
+	k_thread_join(&producer_threads[0], K_FOREVER);
+	zassert_true(spsc_stress.empty());
+}
+
+static MpscQueue<struct item, QUEUE_SIZE> mpsc_stress;
+
+static void mpsc_producer(void *p1, void *p2, void *p3) {
+	uint32_t producer = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < STRESS_ITEMS;) {
+		struct item item = {producer, seq};
+
+		if (mpsc_stress.push(item)) {
+			seq++;
+		} else {
+			k_yield();
+		}
+	}
+}
+
+ZTEST(lockfree_queue, test_mpsc_threads) {
+	uint32_t expected[PRODUCERS] = {};
+	uint32_t received = 0;
+	struct item item;
+
+	for (int i = 0; i < PRODUCERS; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i], STACK_SIZE, mpsc_producer,
+						UINT_TO_POINTER(i), NULL, NULL, own_priority(), 0, K_NO_WAIT);
+	}
+
+	while (received < PRODUCERS * STRESS_ITEMS) {
+		if (!mpsc_stress.pop(item)) {
+			k_yield();
+			continue;
+		}
+
+		zassert_true(item.producer < PRODUCERS);
+		zassert_equal(item.seq, expected[item.producer], "out of order or lost item");
+		expected[item.producer]++;
+		received++;
+	}
+
+	for (int i = 0; i < PRODUCERS; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+	zassert_true(mpsc_stress.empty());
+}
+
+ZTEST_SUITE(lockfree_queue, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <SPI.h>
+
+#include "test_spi.h"
+
+static arduino::ZephyrSPI bus(DEVICE_DT_GET(DT_NODELABEL(test_spi)));
+static const SPISettings settings(1000000, MSBFIRST, SPI_MODE0);
+
+static uint32_t callbacks;
+static int callback_result;
+
+static void count_callback(int result, void *arg) {
+	ARG_UNUSED(arg);
+
+	callback_result = result;
+	callbacks++;
+}
+
+static void before(void *fixture) {
+	ARG_UNUSED(fixture);
+
+	test_spi.transfers = 0;
+	test_spi.releases = 0;
+	test_spi.releases_busy = 0;
+	callbacks = 0;
+	callback_result = -1;
+}
+
+ZTEST(spi_async, test_transfer_async) {
+	uint8_t tx[16], rx[16] = {};
+	arduino::SPIAsyncTransfer xfer;
+
+	for (size_t i = 0; i < sizeof(tx); i++) {
+		tx[i] = i + 1;
+	}
+
+	bus.beginTransaction(settings);
+	zassert_ok(bus.transferAsync(tx, rx, sizeof(tx), xfer, count_callback));
+	zassert_false(xfer.poll(), "transfer over before the controller completed it");
+	zassert_equal(bus.transferAsync(tx, rx, sizeof(tx), xfer), -EBUSY,
+				  "handle reused while its transfer is running");
+
+	zassert_ok(xfer.wait());
+	zassert_true(xfer.poll());
+	zassert_equal(callbacks, 1);
+	zassert_ok(callback_result);
+	zassert_mem_equal(rx, tx, sizeof(tx));
+	bus.endTransaction();
+
+	zassert_equal(test_spi.transfers, 1);
+}
+
+ZTEST(spi_async, test_end_transaction_waits) {
+	uint8_t tx[4] = {0xde, 0xad, 0xbe, 0xef};
+	arduino::SPIAsyncTransfer xfer;
+
+	bus.beginTransaction(settings);
+	zassert_ok(bus.transferAsync(tx, NULL, sizeof(tx), xfer));
+	bus.endTransaction();
+
+	zassert_true(xfer.poll(), "endTransaction() returned with the transfer running");
+	zassert_equal(test_spi.releases, 1);
+	zassert_equal(test_spi.releases_busy, 0, "bus released in the middle of a transfer");
+}
+
+ZTEST(spi_async, test_end_waits) {
+	uint8_t tx[4] = {1, 2, 3, 4};
+	arduino::SPIAsyncTransfer xfer;
+
+	/* Outside of a transaction, with the settings of the last one */
+	zassert_ok(bus.transferAsync(tx, NULL, sizeof(tx), xfer));
+	bus.end();
+
+	zassert_true(xfer.poll(), "end() returned with the transfer running");
+	zassert_equal(test_spi.releases_busy, 0, "bus released in the middle of a transfer");
+}
+
+ZTEST(spi_async, test_back_to_back) {
+	uint8_t tx[8] = {}, rx[8];
+	arduino::SPIAsyncTransfer first, second;
+
+	/* The second transfer waits for the controller instead of failing */
+	bus.beginTransaction(settings);
+	zassert_ok(bus.transferAsync(tx, NULL, sizeof(tx), first));
+	zassert_ok(bus.transferAsync(tx, rx, sizeof(tx), second));
+	zassert_true(first.poll());
+	zassert_ok(second.wait());
+	zassert_equal(bus.transfer(0x5a), 0x5a);
+	bus.endTransaction();
+
+	zassert_equal(test_spi.transfers, 3);
+	zassert_equal(test_spi.releases_busy, 0);
+}
+
+ZTEST_SUITE(spi_async, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT arduino_test_spi_controller
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/kernel.h>
+
+#include "test_spi.h"
+
+struct test_spi_state test_spi;
+
+static struct k_work_delayable complete_work;
+static const struct device *complete_dev;
+static spi_callback_t complete_cb;
+static void *complete_data;
+
+/* Received data is what was sent */
+static void loopback(const struct spi_buf_set *tx, const struct spi_buf_set *rx) {
+	if (!tx || !rx) {
+		return;
+	}
+
+	for (size_t i = 0; i < MIN(tx->count, rx->count); i++) {
+		if (tx->buffers[i].buf && rx->buffers[i].buf) {
+			memcpy(rx->buffers[i].buf, tx->buffers[i].buf,
+				   MIN(tx->buffers[i].len, rx->buffers[i].len));
+		}
+	}
+}
+
+static void complete(struct k_work *work) {
+	ARG_UNUSED(work);
+
+	test_spi.busy = false;
+	complete_cb(complete_dev, 0, complete_data);
+}
+
+static int test_spi_transceive(const struct device *dev, const struct spi_config *config,
+							   const struct spi_buf_set *tx, const struct spi_buf_set *rx) {
+	ARG_UNUSED(dev);
+	ARG_UNUSED(config);
+
+	if (test_spi.busy) {
+		return -EBUSY;
+	}
+
+	test_spi.transfers++;
+	loopback(tx, rx);
+
+	return 0;
+}
+
+static int test_spi_transceive_async(const struct device *dev, const struct spi_config *config,
+									 const struct spi_buf_set *tx, const struct spi_buf_set *rx,
+									 spi_callback_t cb, void *userdata) {
+	ARG_UNUSED(config);
+
+	if (test_spi.busy) {
+		return -EBUSY;
+	}
+
+	test_spi.busy = true;
+	test_spi.transfers++;
+	loopback(tx, rx);
+
+	complete_dev = dev;
+	complete_cb = cb;
+	complete_data = userdata;
+	k_work_schedule(&complete_work, K_MSEC(TEST_SPI_ASYNC_MS));
+
+	return 0;
+}
+
+static int test_spi_release(const struct device *dev, const struct spi_config *config) {
+	ARG_UNUSED(dev);
+	ARG_UNUSED(config);
+
+	test_spi.releases++;
+	if (test_spi.busy) {
+		test_spi.releases_busy++;
+	}
+
+	return 0;
+}
+
+static DEVICE_API(spi, test_spi_api) = {
+	.transceive = test_spi_transceive,
+#ifdef CONFIG_SPI_ASYNC
+	.transceive_async = test_spi_transceive_async,
+#endif
+	.release = test_spi_release,
+};
+
+static int test_spi_init(const struct device *dev) {
+	ARG_UNUSED(dev);
+
+	k_work_init_delayable(&complete_work, complete);
+	return 0;
+}
+
+DEVICE_DT_INST_DEFINE(0, test_spi_init, NULL, NULL, NULL, POST_KERNEL, CONFIG_SPI_INIT_PRIORITY,
+					  &test_spi_api);
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Time an asynchronous transfer takes on the test controller */
+#define TEST_SPI_ASYNC_MS 20
+
+struct test_spi_state {
+	volatile bool busy;
+	uint32_t transfers;
+	uint32_t releases;
+	/* spi_release() calls while an asynchronous transfer was running */
+	uint32_t releases_busy;
+};
+
+extern struct test_spi_state test_spi;
+
+#ifdef __cplusplus
+}
+#endif
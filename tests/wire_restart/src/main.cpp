@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <Wire.h>
+
+#include "test_i2c.h"
+
+#define ADDR_A    0x50
+#define ADDR_B    0x51
+#define ADDR_NONE 0x60
+
+#define WRITE_STOP (I2C_MSG_WRITE | I2C_MSG_STOP)
+#define READ_STOP  (I2C_MSG_READ | I2C_MSG_STOP)
+
+K_THREAD_STACK_DEFINE(other_stack, 1024);
+static struct k_thread other_thread;
+
+static void before(void *fixture) {
+	ARG_UNUSED(fixture);
+
+	memset(&test_i2c, 0, sizeof(test_i2c));
+}
+
+static void check_message(int xfer, int msg, uint8_t flags, uint32_t len) {
+	const struct test_i2c_message *m = &test_i2c.transfers[xfer].msgs[msg];
+
+	zassert_equal(m->flags, flags, "transfer %d message %d: flags 0x%02x", xfer, msg, m->flags);
+	zassert_equal(m->len, len, "transfer %d message %d: length %u", xfer, msg, m->len);
+}
+
+static void other_entry(void *p1, void *p2, void *p3) {
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	Wire.beginTransmission(ADDR_B);
+	Wire.write(0x5a);
+	Wire.endTransmission();
+}
+
+/* Another thread can use the bus, so no lock was left behind */
+static void check_bus_free(void) {
+	int ret;
+
+	k_thread_create(&other_thread, other_stack, K_THREAD_STACK_SIZEOF(other_stack), other_entry,
+					NULL, NULL, NULL, k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	ret = k_thread_join(&other_thread, K_MSEC(100));
+	if (ret < 0) {
+		k_thread_abort(&other_thread);
+	}
+	zassert_ok(ret, "bus still locked");
+}
+
+ZTEST(wire_restart, test_write) {
+	Wire.beginTransmission(ADDR_A);
+	Wire.write(0x01);
+	Wire.write(0x02);
+	zassert_equal(Wire.endTransmission(), 0);
+
+	zassert_equal(test_i2c.count, 1);
+	zassert_equal(test_i2c.transfers[0].addr, ADDR_A);
+	zassert_equal(test_i2c.transfers[0].num, 1);
+	check_message(0, 0, WRITE_STOP, 2);
+	zassert_equal(test_i2c.transfers[0].msgs[0].data[0], 0x01);
+	zassert_equal(test_i2c.transfers[0].msgs[0].data[1], 0x02);
+}
+
+ZTEST(wire_restart, test_write_restart_read) {
+	Wire.beginTransmission(ADDR_A);
+	Wire.write(0x10);
+	zassert_equal(Wire.endTransmission(false), 0);
+	zassert_equal(test_i2c.count, 0, "write sent before the read");
+
+	zassert_equal(Wire.requestFrom(ADDR_A, 2), 2);
+
+	/* A single transaction, with a repeated start before the read */
+	zassert_equal(test_i2c.count, 1);
+	zassert_equal(test_i2c.transfers[0].addr, ADDR_A);
+	zassert_equal(test_i2c.transfers[0].num, 2);
+	check_message(0, 0, I2C_MSG_WRITE, 1);
+	zassert_equal(test_i2c.transfers[0].msgs[0].data[0], 0x10);
+	check_message(0, 1, READ_STOP | I2C_MSG_RESTART, 2);
+
+	zassert_equal(Wire.available(), 2);
+	zassert_equal(Wire.read(), TEST_I2C_READ_BASE);
+	zassert_equal(Wire.read(), TEST_I2C_READ_BASE + 1);
+
+	check_bus_free();
+}
+
+ZTEST(wire_restart, test_restart_other_address_read) {
+	Wire.beginTransmission(ADDR_A);
+	Wire.write(0x10);
+	zassert_equal(Wire.endTransmission(false), 0);
+
+	/* The deferred write cannot be combined, it goes out on its own first */
+	zassert_equal(Wire.requestFrom(ADDR_B, 1), 1);
+
+	zassert_equal(test_i2c.count, 2);
+	zassert_equal(test_i2c.transfers[0].addr, ADDR_A);
+	zassert_equal(test_i2c.transfers[0].num, 1);
+	check_message(0, 0, WRITE_STOP, 1);
+	zassert_equal(test_i2c.transfers[0].msgs[0].data[0], 0x10);
+
+	zassert_equal(test_i2c.transfers[1].addr, ADDR_B);
+	zassert_equal(test_i2c.transfers[1].num, 1);
+	check_message(1, 0, READ_STOP, 1);
+
+	check_bus_free();
+}
+
+ZTEST(wire_restart, test_restart_other_address_write) {
+	Wire.beginTransmission(ADDR_A);
+	Wire.write(0x10);
+	zassert_equal(Wire.endTransmission(false), 0);
+
+	Wire.beginTransmission(ADDR_B);
+	Wire.write(0x20);
+	zassert_equal(Wire.endTransmission(), 0);
+
+	zassert_equal(test_i2c.count, 2);
+	zassert_equal(test_i2c.transfers[0].addr, ADDR_A);
+	check_message(0, 0, WRITE_STOP, 1);
+	zassert_equal(test_i2c.transfers[0].msgs[0].data[0], 0x10);
+
+	zassert_equal(test_i2c.transfers[1].addr, ADDR_B);
+	check_message(1, 0, WRITE_STOP, 1);
+	zassert_equal(test_i2c.transfers[1].msgs[0].data[0], 0x20);
+
+	check_bus_free();
+}
+
+ZTEST(wire_restart, test_probe) {
+	Wire.beginTransmission(ADDR_A);
+	zassert_equal(Wire.endTransmission(), 0);
+
+	zassert_equal(test_i2c.count, 1);
+	zassert_equal(test_i2c.transfers[0].num, 1);
+	check_message(0, 0, WRITE_STOP, 0);
+
+	/* Nothing answers at this address */
+	Wire.beginTransmission(ADDR_NONE);
+	zassert_not_equal(Wire.endTransmission(), 0);
+
+	check_bus_free();
+}
+
+ZTEST(wire_restart, test_deferred_probe) {
+	Wire.beginTransmission(ADDR_A);
+	zassert_equal(Wire.endTransmission(false), 0);
+	zassert_equal(test_i2c.count, 0);
+
+	/* Moving to another address sends the empty write as a probe */
+	Wire.beginTransmission(ADDR_B);
+	zassert_equal(Wire.endTransmission(), 0);
+
+	zassert_equal(test_i2c.count, 2);
+	zassert_equal(test_i2c.transfers[0].addr, ADDR_A);
+	zassert_equal(test_i2c.transfers[0].num, 1);
+	check_message(0, 0, WRITE_STOP, 0);
+	zassert_equal(test_i2c.transfers[1].addr, ADDR_B);
+	check_message(1, 0, WRITE_STOP, 0);
+
+	check_bus_free();
+}
+
+ZTEST(wire_restart, test_deferred_empty_read) {
+	Wire.beginTransmission(ADDR_A);
+	zassert_equal(Wire.endTransmission(false), 0);
+
+	/* An empty deferred write is dropped in front of a read to the same address */
+	zassert_equal(Wire.requestFrom(ADDR_A, 1), 1);
+
+	zassert_equal(test_i2c.count, 1);
+	zassert_equal(test_i2c.transfers[0].num, 1);
+	check_message(0, 0, READ_STOP, 1);
+
+	check_bus_free();
+}
+
+ZTEST(wire_restart, test_read_registers) {
+	uint8_t buf[3] = {};
+
+	zassert_ok(Wire.readRegisters(ADDR_A, 0x20, buf, sizeof(buf)));
+
+	zassert_equal(test_i2c.count, 1);
+	zassert_equal(test_i2c.transfers[0].num, 2);
+	check_message(0, 0, I2C_MSG_WRITE, 1);
+	zassert_equal(test_i2c.transfers[0].msgs[0].data[0], 0x20);
+	check_message(0, 1, READ_STOP | I2C_MSG_RESTART, sizeof(buf));
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		zassert_equal(buf[i], TEST_I2C_READ_BASE + i);
+	}
+
+	check_bus_free();
+}
+
+ZTEST_SUITE(wire_restart, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT arduino_test_i2c_target
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+
+#include "test_i2c.h"
+
+struct test_i2c_log test_i2c;
+
+static int test_i2c_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+							 int addr) {
+	struct test_i2c_transfer *xfer;
+
+	ARG_UNUSED(target);
+
+	if (test_i2c.count >= TEST_I2C_TRANSFERS || num_msgs > TEST_I2C_MESSAGES) {
+		return -ENOMEM;
+	}
+
+	xfer = &test_i2c.transfers[test_i2c.count++];
+	xfer->addr = addr;
+	xfer->num = num_msgs;
+
+	for (int i = 0; i < num_msgs; i++) {
+		xfer->msgs[i].flags = msgs[i].flags;
+		xfer->msgs[i].len = msgs[i].len;
+
+		if (msgs[i].flags & I2C_MSG_READ) {
+			for (uint32_t j = 0; j < msgs[i].len; j++) {
+				msgs[i].buf[j] = TEST_I2C_READ_BASE + j;
+			}
+		} else if (msgs[i].len) {
+			memcpy(xfer->msgs[i].data, msgs[i].buf, MIN(msgs[i].len, TEST_I2C_DATA));
+		}
+	}
+
+	return 0;
+}
+
+static const struct i2c_emul_api test_i2c_api = {
+	.transfer = test_i2c_transfer,
+};
+
+static int test_i2c_init(const struct emul *target, const struct device *parent) {
+	ARG_UNUSED(target);
+	ARG_UNUSED(parent);
+
+	return 0;
+}
+
+#define TEST_I2C_DEFINE(n)                                                                         \
+	DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL,                                  \
+						  CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);                               \
+	EMUL_DT_INST_DEFINE(n, test_i2c_init, NULL, NULL, &test_i2c_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(TEST_I2C_DEFINE)
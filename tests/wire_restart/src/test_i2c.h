@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Arduino SA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEST_I2C_TRANSFERS 8
+#define TEST_I2C_MESSAGES  4
+#define TEST_I2C_DATA      4
+
+/* Read messages are answered with TEST_I2C_READ_BASE, TEST_I2C_READ_BASE + 1, ... */
+#define TEST_I2C_READ_BASE 0xa0
+
+struct test_i2c_message {
+	uint8_t flags;
+	uint32_t len;
+	/* First bytes of a write */
+	uint8_t data[TEST_I2C_DATA];
+};
+
+struct test_i2c_transfer {
+	uint16_t addr;
+	int num;
+	struct test_i2c_message msgs[TEST_I2C_MESSAGES];
+};
+
+/* Transfers seen by the emulated targets, in order */
+struct test_i2c_log {
+	int count;
+	struct test_i2c_transfer transfers[TEST_I2C_TRANSFERS];
+};
+
+extern struct test_i2c_log test_i2c;
+
+#ifdef __cplusplus
+}
+#endif